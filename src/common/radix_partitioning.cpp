@@ -84,6 +84,43 @@ idx_t RadixPartitioning::Select(Vector &hashes, const SelectionVector *sel, idx_
 	return RadixBitsSwitch<SelectFunctor, idx_t>(radix_bits, hashes, sel, count, cutoff, true_sel, false_sel);
 }
 
+struct SelectPartitionsFunctor {
+	template <idx_t radix_bits>
+	static idx_t Operation(Vector &hashes, const SelectionVector *sel, idx_t count, const vector<bool> &partitions,
+	                       SelectionVector *true_sel, SelectionVector *false_sel) {
+		using CONSTANTS = RadixPartitioningConstants<radix_bits>;
+		D_ASSERT(partitions.size() == CONSTANTS::NUM_PARTITIONS);
+		UnifiedVectorFormat hdata;
+		hashes.ToUnifiedFormat(count, hdata);
+		auto hash_data = UnifiedVectorFormat::GetData<hash_t>(hdata);
+		idx_t true_count = 0;
+		idx_t false_count = 0;
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = sel ? sel->get_index(i) : i;
+			auto hash_idx = hdata.sel->get_index(idx);
+			if (partitions[CONSTANTS::ApplyMask(hash_data[hash_idx])]) {
+				if (true_sel) {
+					true_sel->set_index(true_count, idx);
+				}
+				true_count++;
+			} else {
+				if (false_sel) {
+					false_sel->set_index(false_count, idx);
+				}
+				false_count++;
+			}
+		}
+		return true_count;
+	}
+};
+
+idx_t RadixPartitioning::Select(Vector &hashes, const SelectionVector *sel, idx_t count, idx_t radix_bits,
+                                const vector<bool> &partitions, SelectionVector *true_sel,
+                                SelectionVector *false_sel) {
+	return RadixBitsSwitch<SelectPartitionsFunctor, idx_t>(radix_bits, hashes, sel, count, partitions, true_sel,
+	                                                       false_sel);
+}
+
 struct ComputePartitionIndicesFunctor {
 	template <idx_t radix_bits>
 	static void Operation(Vector &hashes, Vector &partition_indices, idx_t count) {
@@ -190,17 +190,159 @@ static idx_t GenericNestedMatch(Vector &lhs_vector, const TupleDataVectorFormat
 	return SelectComparison<OP>(sliced, key, sel, count, &sel, nullptr);
 }
 
+//! A key column of the specialized matchers, which are only used for EQUAL, so NULLs never match
+template <class T>
+struct KeyMatchColumn {
+	KeyMatchColumn(const TupleDataVectorFormat &lhs_format, const TupleDataLayout &rhs_layout, const idx_t col_idx)
+	    : lhs_sel(*lhs_format.unified.sel), lhs_data(UnifiedVectorFormat::GetData<T>(lhs_format.unified)),
+	      lhs_validity(lhs_format.unified.validity), rhs_offset_in_row(rhs_layout.GetOffsets()[col_idx]) {
+		ValidityBytes::GetEntryIndex(col_idx, entry_idx, idx_in_entry);
+	}
+
+	template <bool LHS_ALL_VALID>
+	inline bool Match(const idx_t idx, const data_ptr_t rhs_location) const {
+		const auto lhs_idx = lhs_sel.get_index(idx);
+		const ValidityBytes rhs_mask(rhs_location);
+		bool valid = rhs_mask.RowIsValid(rhs_mask.GetValidityEntryUnsafe(entry_idx), idx_in_entry);
+		if (!LHS_ALL_VALID) {
+			valid = valid && lhs_validity.RowIsValid(lhs_idx);
+		}
+		return valid && lhs_data[lhs_idx] == Load<T>(rhs_location + rhs_offset_in_row);
+	}
+
+	const SelectionVector &lhs_sel;
+	const T *lhs_data;
+	const ValidityMask &lhs_validity;
+	const idx_t rhs_offset_in_row;
+	idx_t entry_idx;
+	idx_t idx_in_entry;
+};
+
+template <bool NO_MATCH_SEL, bool LHS_ALL_VALID, class T>
+static idx_t TemplatedKeyMatch(const vector<TupleDataVectorFormat> &lhs_formats, SelectionVector &sel,
+                               const idx_t count, const TupleDataLayout &rhs_layout, Vector &rhs_row_locations,
+                               SelectionVector *no_match_sel, idx_t &no_match_count) {
+	const KeyMatchColumn<T> column(lhs_formats[0], rhs_layout, 0);
+	const auto rhs_locations = FlatVector::GetData<data_ptr_t>(rhs_row_locations);
+
+	// the selection vectors are written without branches, as whether a row matches is hard to predict
+	idx_t match_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		const auto idx = sel.get_index(i);
+		const auto match = column.template Match<LHS_ALL_VALID>(idx, rhs_locations[idx]);
+		sel.set_index(match_count, idx);
+		match_count += match;
+		if (NO_MATCH_SEL) {
+			no_match_sel->set_index(no_match_count, idx);
+			no_match_count += !match;
+		}
+	}
+	return match_count;
+}
+
+template <bool NO_MATCH_SEL, bool LHS_ALL_VALID, class T0, class T1>
+static idx_t TemplatedKeyMatch(const vector<TupleDataVectorFormat> &lhs_formats, SelectionVector &sel,
+                               const idx_t count, const TupleDataLayout &rhs_layout, Vector &rhs_row_locations,
+                               SelectionVector *no_match_sel, idx_t &no_match_count) {
+	const KeyMatchColumn<T0> column0(lhs_formats[0], rhs_layout, 0);
+	const KeyMatchColumn<T1> column1(lhs_formats[1], rhs_layout, 1);
+	const auto rhs_locations = FlatVector::GetData<data_ptr_t>(rhs_row_locations);
+
+	// both columns are compared in the same pass, so every row is only loaded once
+	idx_t match_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		const auto idx = sel.get_index(i);
+		const auto rhs_location = rhs_locations[idx];
+		const auto match = column0.template Match<LHS_ALL_VALID>(idx, rhs_location) &
+		                   column1.template Match<LHS_ALL_VALID>(idx, rhs_location);
+		sel.set_index(match_count, idx);
+		match_count += match;
+		if (NO_MATCH_SEL) {
+			no_match_sel->set_index(no_match_count, idx);
+			no_match_count += !match;
+		}
+	}
+	return match_count;
+}
+
+template <bool NO_MATCH_SEL, class... T>
+static idx_t KeyMatch(const vector<TupleDataVectorFormat> &lhs_formats, SelectionVector &sel, const idx_t count,
+                      const TupleDataLayout &rhs_layout, Vector &rhs_row_locations, SelectionVector *no_match_sel,
+                      idx_t &no_match_count) {
+	for (idx_t col_idx = 0; col_idx < sizeof...(T); col_idx++) {
+		if (!lhs_formats[col_idx].unified.validity.AllValid()) {
+			return TemplatedKeyMatch<NO_MATCH_SEL, false, T...>(lhs_formats, sel, count, rhs_layout,
+			                                                    rhs_row_locations, no_match_sel, no_match_count);
+		}
+	}
+	return TemplatedKeyMatch<NO_MATCH_SEL, true, T...>(lhs_formats, sel, count, rhs_layout, rhs_row_locations,
+	                                                   no_match_sel, no_match_count);
+}
+
+template <bool NO_MATCH_SEL, class T0>
+static key_match_function_t GetKeyMatchFunction(const PhysicalType type1) {
+	switch (type1) {
+	case PhysicalType::INT32:
+		return KeyMatch<NO_MATCH_SEL, T0, int32_t>;
+	case PhysicalType::INT64:
+		return KeyMatch<NO_MATCH_SEL, T0, int64_t>;
+	case PhysicalType::INT128:
+		return KeyMatch<NO_MATCH_SEL, T0, hugeint_t>;
+	default:
+		return nullptr;
+	}
+}
+
+template <bool NO_MATCH_SEL, class T0>
+static key_match_function_t GetKeyMatchFunction(const vector<PhysicalType> &types) {
+	return types.size() == 1 ? KeyMatch<NO_MATCH_SEL, T0> : GetKeyMatchFunction<NO_MATCH_SEL, T0>(types[1]);
+}
+
+template <bool NO_MATCH_SEL>
+static key_match_function_t GetKeyMatchFunction(const vector<PhysicalType> &types) {
+	switch (types[0]) {
+	case PhysicalType::INT32:
+		return GetKeyMatchFunction<NO_MATCH_SEL, int32_t>(types);
+	case PhysicalType::INT64:
+		return GetKeyMatchFunction<NO_MATCH_SEL, int64_t>(types);
+	case PhysicalType::INT128:
+		return GetKeyMatchFunction<NO_MATCH_SEL, hugeint_t>(types);
+	default:
+		return nullptr;
+	}
+}
+
 void RowMatcher::Initialize(const bool no_match_sel, const TupleDataLayout &layout, const Predicates &predicates) {
 	match_functions.reserve(predicates.size());
 	for (idx_t col_idx = 0; col_idx < predicates.size(); col_idx++) {
 		match_functions.push_back(GetMatchFunction(no_match_sel, layout.GetTypes()[col_idx], predicates[col_idx]));
 	}
+	key_match_function = GetKeyMatchFunction(no_match_sel, layout, predicates);
+}
+
+key_match_function_t RowMatcher::GetKeyMatchFunction(const bool no_match_sel, const TupleDataLayout &layout,
+                                                     const Predicates &predicates) {
+	if (predicates.empty() || predicates.size() > 2) {
+		return nullptr;
+	}
+	vector<PhysicalType> types;
+	for (idx_t col_idx = 0; col_idx < predicates.size(); col_idx++) {
+		if (predicates[col_idx] != ExpressionType::COMPARE_EQUAL) {
+			return nullptr;
+		}
+		types.push_back(layout.GetTypes()[col_idx].InternalType());
+	}
+	return no_match_sel ? duckdb::GetKeyMatchFunction<true>(types) : duckdb::GetKeyMatchFunction<false>(types);
 }
 
 idx_t RowMatcher::Match(DataChunk &lhs, const vector<TupleDataVectorFormat> &lhs_formats, SelectionVector &sel,
                         idx_t count, const TupleDataLayout &rhs_layout, Vector &rhs_row_locations,
                         SelectionVector *no_match_sel, idx_t &no_match_count) {
 	D_ASSERT(!match_functions.empty());
+	if (key_match_function) {
+		return key_match_function(lhs_formats, sel, count, rhs_layout, rhs_row_locations, no_match_sel,
+		                          no_match_count);
+	}
 	for (idx_t col_idx = 0; col_idx < match_functions.size(); col_idx++) {
 		const auto &match_function = match_functions[col_idx];
 		count =
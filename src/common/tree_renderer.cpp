@@ -474,7 +474,12 @@ unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const LogicalOperator &op) {
 }
 
 unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const PhysicalOperator &op) {
-	return CreateRenderNode(op.GetName(), op.ParamsToString());
+	auto params = op.ParamsToString();
+	auto compaction = op.CompactionToString();
+	if (!compaction.empty()) {
+		params += params.empty() ? compaction : "\n[INFOSEPARATOR]\n" + compaction;
+	}
+	return CreateRenderNode(op.GetName(), params);
 }
 
 unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const PipelineRenderNode &op) {
@@ -501,6 +506,10 @@ unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const QueryProfiler::TreeNod
 	result->extra_text += "\n" + to_string(op.info.elements);
 	string timing = StringUtil::Format("%.2f", op.info.time);
 	result->extra_text += "\n(" + timing + "s)";
+	if (!op.info.chunk_stats.IsEmpty()) {
+		result->extra_text += "\n[INFOSEPARATOR]";
+		result->extra_text += "\n" + op.info.chunk_stats.ToString();
+	}
 	if (config.detailed) {
 		for (auto &info : op.info.executors_info) {
 			if (!info) {
@@ -218,6 +218,21 @@ void Vector::Slice(const SelectionVector &sel, idx_t count, SelCache &cache) {
 // currently, we only consider the flat vector and the dictionary vector.
 void Vector::ConcatenateSlice(Vector &other, const SelectionVector &sel, idx_t count, idx_t base_count,
                               SelCache &sel_cache) {
+	if (GetType().InternalType() == PhysicalType::STRUCT) {
+		// struct vectors have no data pointer to compare against, and a sliced struct holds its own sliced children:
+		// start a new slice for the first rows and copy the other rows behind them
+		if (base_count == 0) {
+			Reference(other);
+			Slice(sel, count);
+		} else {
+			Vector flat(GetType());
+			VectorOperations::Copy(*this, flat, base_count, 0, 0);
+			VectorOperations::Copy(other, flat, sel, count, 0, base_count);
+			Reference(flat);
+		}
+		return;
+	}
+
 	if (this->data != other.data) {
 		Reference(other);
 		Slice(sel, count);
@@ -0,0 +1,88 @@
+#include "duckdb/execution/compaction_placement.hpp"
+
+#include "duckdb/common/enums/join_type.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/execution/operator/join/physical_index_join.hpp"
+#include "duckdb/execution/operator/join/physical_join.hpp"
+
+namespace duckdb {
+
+void CompactionPlacement::Place(PhysicalOperator &plan) {
+	Visit(plan, nullptr, 0);
+}
+
+//! Whether the operator emits exactly the rows it receives, so it passes on the density of its input
+static bool PreservesDensity(const PhysicalOperator &op) {
+	return op.type == PhysicalOperatorType::PROJECTION;
+}
+
+static bool IsProbe(const PhysicalOperator &consumer, idx_t child_idx) {
+	switch (consumer.type) {
+		case PhysicalOperatorType::HASH_JOIN:
+		case PhysicalOperatorType::NESTED_LOOP_JOIN:
+		case PhysicalOperatorType::PIECEWISE_MERGE_JOIN:
+		case PhysicalOperatorType::INDEX_JOIN:
+			return child_idx == 0;
+		default:
+			return false;
+	}
+}
+
+void CompactionPlacement::Visit(PhysicalOperator &op, optional_ptr<PhysicalOperator> consumer, idx_t child_idx) {
+	auto compacting = dynamic_cast<CompactingPhysicalOperator *>(&op);
+	if (compacting && compacting->compacting_supported) {
+		Decide(*compacting, consumer, child_idx);
+	}
+	for (idx_t i = 0; i < op.children.size(); i++) {
+		if (PreservesDensity(op)) {
+			// look through the operator: its output is as dense as its input
+			Visit(*op.children[i], consumer, child_idx);
+		} else {
+			Visit(*op.children[i], &op, i);
+		}
+	}
+}
+
+void CompactionPlacement::Decide(CompactingPhysicalOperator &op, optional_ptr<PhysicalOperator> consumer,
+                                 idx_t child_idx) {
+	if (consumer && IsProbe(*consumer, child_idx)) {
+		// probing costs the same per chunk however few rows it holds: always compact before a probe
+		op.compaction_info = "probe of " + consumer->GetName();
+		return;
+	}
+	if (consumer && (consumer->SinkAcceptsFragments() || consumer->type == PhysicalOperatorType::HASH_JOIN)) {
+		// a build side or aggregate sink takes chunks of any size: compacting only adds copies
+		op.compacting_supported = false;
+		op.compaction_info = "sink " + consumer->GetName();
+		return;
+	}
+	if (op.children.empty()) {
+		op.compaction_info = "enabled";
+		return;
+	}
+	auto input_cardinality = op.children[0]->estimated_cardinality;
+	if (input_cardinality <= STANDARD_VECTOR_SIZE) {
+		// the input fits in a single chunk, there is nothing to compact it with
+		op.compacting_supported = false;
+		op.compaction_info = "single input chunk";
+		return;
+	}
+	bool may_filter = op.type == PhysicalOperatorType::FILTER;
+	if (op.type != PhysicalOperatorType::CROSS_PRODUCT && !may_filter) {
+		// the index join is the only compacting join that does not derive from PhysicalJoin
+		auto join_type = op.type == PhysicalOperatorType::INDEX_JOIN ? op.Cast<PhysicalIndexJoin>().join_type
+		                                                              : op.Cast<PhysicalJoin>().join_type;
+		may_filter = join_type == JoinType::SEMI || join_type == JoinType::ANTI || join_type == JoinType::INNER;
+	}
+	if (!may_filter || op.estimated_cardinality >= input_cardinality) {
+		// the operator is estimated to emit at least as many rows as it receives, so its chunks stay full
+		op.compacting_supported = false;
+		op.compaction_info = StringUtil::Format("dense output (%llu of %llu rows)", op.estimated_cardinality,
+		                                        input_cardinality);
+		return;
+	}
+	op.compaction_info =
+	    StringUtil::Format("selectivity %.2f", double(op.estimated_cardinality) / double(input_cardinality));
+}
+
+} // namespace duckdb
@@ -4,9 +4,12 @@
 #include "duckdb/common/row_operations/row_operations.hpp"
 #include "duckdb/common/types/column/column_data_collection_segment.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/operator/join/join_runtime_filter.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 
+#include <numeric>
+
 namespace duckdb {
 
 using ValidityBytes = JoinHashTable::ValidityBytes;
@@ -14,11 +17,9 @@ using ScanStructure = JoinHashTable::ScanStructure;
 using ProbeSpill = JoinHashTable::ProbeSpill;
 using ProbeSpillLocalState = JoinHashTable::ProbeSpillLocalAppendState;
 
-JoinHashTable::JoinHashTable(BufferManager &buffer_manager_p, const vector<JoinCondition> &conditions_p,
+JoinHashTable::JoinHashTable(BufferManager &buffer_manager_p, const vector<JoinCondition> &conditions,
                              vector<LogicalType> btypes, JoinType type_p)
-    : buffer_(make_uniq<DataChunk>()),
-      buffer_manager(buffer_manager_p),
-      conditions(conditions_p),
+    : buffer_manager(buffer_manager_p),
       build_types(std::move(btypes)),
       entry_size(0),
       tuple_size(0),
@@ -95,32 +96,100 @@ void JoinHashTable::Merge(JoinHashTable &other) {
 	sink_collection->Combine(*other.sink_collection);
 }
 
-void JoinHashTable::ApplyBitmask(Vector &hashes, idx_t count) {
-	if (hashes.GetVectorType() == VectorType::CONSTANT_VECTOR) {
-		D_ASSERT(!ConstantVector::IsNull(hashes));
-		auto indices = ConstantVector::GetData<hash_t>(hashes);
-		*indices = *indices & bitmask;
-	} else {
-		hashes.Flatten(count);
-		auto indices = FlatVector::GetData<hash_t>(hashes);
+//! Hints the CPU to load the cache line of the address, so that it is (being) loaded once it is accessed
+static inline void PrefetchAddress(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(address);
+#endif
+}
+
+template <bool PREFETCH>
+static void TemplatedGetChainHeads(const hash_t entries[], const idx_t bucket_shift, const uint64_t bitmask,
+                                   const UnifiedVectorFormat &hdata, const SelectionVector &sel, idx_t count,
+                                   data_ptr_t result_data[]) {
+	auto hash_data = UnifiedVectorFormat::GetData<hash_t>(hdata);
+	if (PREFETCH) {
+		// group prefetching: issue the loads of all entries before the first one is needed
 		for (idx_t i = 0; i < count; i++) {
-			indices[i] &= bitmask;
+			auto hindex = hdata.sel->get_index(sel.get_index(i));
+			PrefetchAddress(entries + ((hash_data[hindex] >> bucket_shift) & bitmask));
 		}
 	}
+	for (idx_t i = 0; i < count; i++) {
+		auto rindex = sel.get_index(i);
+		auto hindex = hdata.sel->get_index(rindex);
+		auto hash = hash_data[hindex];
+		auto entry = entries[(hash >> bucket_shift) & bitmask];
+		// if the tag bit of the hash is not set, no tuple in the chain has this hash: skip it without touching it
+		auto pointer = (entry & JoinHashTable::ExtractTag(hash)) ? JoinHashTable::ExtractPointer(entry) : nullptr;
+		if (PREFETCH && pointer) {
+			// the keys of the first tuple are compared once all chain heads are known
+			PrefetchAddress(pointer);
+		}
+		result_data[rindex] = pointer;
+	}
 }
 
-void JoinHashTable::ApplyBitmask(Vector &hashes, const SelectionVector &sel, idx_t count, Vector &pointers) {
-	UnifiedVectorFormat hdata;
-	hashes.ToUnifiedFormat(count, hdata);
+//! Finds the first tuple at or after the slot whose salt matches, or returns nullptr once an empty slot is reached
+static inline data_ptr_t FindSaltMatch(const hash_t entries[], const uint64_t bitmask, const hash_t salt, idx_t &slot) {
+	while (true) {
+		const auto entry = entries[slot];
+		if (!entry) {
+			return nullptr;
+		}
+		if ((entry & JoinHashTable::TAG_MASK) == salt) {
+			return JoinHashTable::ExtractPointer(entry);
+		}
+		slot = (slot + 1) & bitmask;
+	}
+}
 
+template <bool PREFETCH>
+static void TemplatedFindSlots(const hash_t entries[], const idx_t bucket_shift, const uint64_t bitmask,
+                               const UnifiedVectorFormat &hdata, const SelectionVector &sel, idx_t count,
+                               data_ptr_t result_data[], idx_t slots[], hash_t salts[]) {
 	auto hash_data = UnifiedVectorFormat::GetData<hash_t>(hdata);
-	auto result_data = FlatVector::GetData<data_ptr_t *>(pointers);
-	auto main_ht = reinterpret_cast<data_ptr_t *>(hash_map.get());
+	if (PREFETCH) {
+		for (idx_t i = 0; i < count; i++) {
+			auto hindex = hdata.sel->get_index(sel.get_index(i));
+			PrefetchAddress(entries + ((hash_data[hindex] >> bucket_shift) & bitmask));
+		}
+	}
 	for (idx_t i = 0; i < count; i++) {
 		auto rindex = sel.get_index(i);
 		auto hindex = hdata.sel->get_index(rindex);
 		auto hash = hash_data[hindex];
-		result_data[rindex] = main_ht + (hash & bitmask);
+		idx_t slot = (hash >> bucket_shift) & bitmask;
+		auto salt = JoinHashTable::ExtractSalt(hash);
+		auto pointer = FindSaltMatch(entries, bitmask, salt, slot);
+		if (PREFETCH && pointer) {
+			PrefetchAddress(pointer);
+		}
+		result_data[rindex] = pointer;
+		slots[rindex] = slot;
+		salts[rindex] = salt;
+	}
+}
+
+void JoinHashTable::GetChainHeads(Vector &hashes, const SelectionVector &sel, idx_t count, ScanStructure &ss) {
+	UnifiedVectorFormat hdata;
+	hashes.ToUnifiedFormat(count, hdata);
+
+	auto result_data = FlatVector::GetData<data_ptr_t>(ss.pointers);
+	auto entries = reinterpret_cast<hash_t *>(hash_map.get());
+	if (linear_probing) {
+		D_ASSERT(ss.slots && ss.salts);
+		auto slots = ss.slots.get();
+		auto salts = ss.salts.get();
+		if (prefetch_probe) {
+			TemplatedFindSlots<true>(entries, bucket_shift, bitmask, hdata, sel, count, result_data, slots, salts);
+		} else {
+			TemplatedFindSlots<false>(entries, bucket_shift, bitmask, hdata, sel, count, result_data, slots, salts);
+		}
+	} else if (prefetch_probe) {
+		TemplatedGetChainHeads<true>(entries, bucket_shift, bitmask, hdata, sel, count, result_data);
+	} else {
+		TemplatedGetChainHeads<false>(entries, bucket_shift, bitmask, hdata, sel, count, result_data);
 	}
 }
 
@@ -256,22 +325,56 @@ idx_t JoinHashTable::PrepareKeys(DataChunk &keys, vector<TupleDataVectorFormat>
 }
 
 template <bool PARALLEL>
-static inline void InsertHashesLoop(atomic<data_ptr_t> pointers[], const hash_t indices[], const idx_t count,
-                                    const data_ptr_t key_locations[], const idx_t pointer_offset) {
+static inline void InsertHashesLoop(hash_t entries[], const hash_t hashes[], const idx_t count,
+                                    const data_ptr_t key_locations[], const idx_t pointer_offset,
+                                    const idx_t bucket_shift, const uint64_t bitmask) {
 	for (idx_t i = 0; i < count; i++) {
-		const auto index = indices[i];
+		const auto hash = hashes[i];
+		auto &entry = entries[(hash >> bucket_shift) & bitmask];
+		// the tag of the entry accumulates the tag bits of all hashes in the chain
+		const auto tag = JoinHashTable::ExtractTag(hash);
+		const auto pointer = reinterpret_cast<uint64_t>(key_locations[i]);
+		// Pointer shouldn't use upper bits
+		D_ASSERT((pointer & JoinHashTable::TAG_MASK) == 0);
 		if (PARALLEL) {
-			data_ptr_t head;
+			auto &atomic_entry = reinterpret_cast<atomic<hash_t> &>(entry);
+			hash_t head = atomic_entry;
 			do {
-				head = pointers[index];
-				Store<data_ptr_t>(head, key_locations[i] + pointer_offset);
-			} while (!std::atomic_compare_exchange_weak(&pointers[index], &head, key_locations[i]));
+				Store<data_ptr_t>(JoinHashTable::ExtractPointer(head), key_locations[i] + pointer_offset);
+			} while (!std::atomic_compare_exchange_weak(&atomic_entry, &head,
+			                                            (head & JoinHashTable::TAG_MASK) | tag | pointer));
 		} else {
 			// set prev in current key to the value (NOTE: this will be nullptr if there is none)
-			Store<data_ptr_t>(pointers[index], key_locations[i] + pointer_offset);
+			const hash_t head = entry;
+			Store<data_ptr_t>(JoinHashTable::ExtractPointer(head), key_locations[i] + pointer_offset);
 
 			// set pointer to current tuple
-			pointers[index] = key_locations[i];
+			entry = (head & JoinHashTable::TAG_MASK) | tag | pointer;
+		}
+	}
+}
+
+template <bool PARALLEL>
+static inline void InsertLinearProbingLoop(atomic<hash_t> entries[], const hash_t hashes[], const idx_t count,
+                                           const data_ptr_t key_locations[], const idx_t bucket_shift,
+                                           const uint64_t bitmask) {
+	for (idx_t i = 0; i < count; i++) {
+		const auto hash = hashes[i];
+		const auto pointer = reinterpret_cast<uint64_t>(key_locations[i]);
+		// Pointer shouldn't use upper bits
+		D_ASSERT((pointer & JoinHashTable::TAG_MASK) == 0);
+		const auto new_entry = JoinHashTable::ExtractSalt(hash) | pointer;
+		// the table is at most half full, so we always find an empty slot
+		for (idx_t slot = (hash >> bucket_shift) & bitmask;; slot = (slot + 1) & bitmask) {
+			if (PARALLEL) {
+				hash_t expected = 0;
+				if (std::atomic_compare_exchange_strong(&entries[slot], &expected, new_entry)) {
+					break;
+				}
+			} else if (entries[slot] == 0) {
+				entries[slot] = new_entry;
+				break;
+			}
 		}
 	}
 }
@@ -279,19 +382,25 @@ static inline void InsertHashesLoop(atomic<data_ptr_t> pointers[], const hash_t
 void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_locations[], bool parallel) {
 	D_ASSERT(hashes.GetType().id() == LogicalType::HASH);
 
-	// use bitmask to get position in array
-	ApplyBitmask(hashes, count);
-
 	hashes.Flatten(count);
 	D_ASSERT(hashes.GetVectorType() == VectorType::FLAT_VECTOR);
 
-	auto pointers = reinterpret_cast<atomic<data_ptr_t> *>(hash_map.get());
-	auto indices = FlatVector::GetData<hash_t>(hashes);
+	// the bitmask is applied in the loop, as the upper bits of the hashes are needed for the tags
+	auto hash_data = FlatVector::GetData<hash_t>(hashes);
 
-	if (parallel) {
-		InsertHashesLoop<true>(pointers, indices, count, key_locations, pointer_offset);
+	if (linear_probing) {
+		auto entries = reinterpret_cast<atomic<hash_t> *>(hash_map.get());
+		if (parallel) {
+			InsertLinearProbingLoop<true>(entries, hash_data, count, key_locations, bucket_shift, bitmask);
+		} else {
+			InsertLinearProbingLoop<false>(entries, hash_data, count, key_locations, bucket_shift, bitmask);
+		}
+	} else if (parallel) {
+		auto entries = reinterpret_cast<hash_t *>(hash_map.get());
+		InsertHashesLoop<true>(entries, hash_data, count, key_locations, pointer_offset, bucket_shift, bitmask);
 	} else {
-		InsertHashesLoop<false>(pointers, indices, count, key_locations, pointer_offset);
+		auto entries = reinterpret_cast<hash_t *>(hash_map.get());
+		InsertHashesLoop<false>(entries, hash_data, count, key_locations, pointer_offset, bucket_shift, bitmask);
 	}
 }
 
@@ -301,24 +410,30 @@ void JoinHashTable::InitializePointerTable() {
 
 	if (hash_map.get()) {
 		// There is already a hash map
-		auto current_capacity = hash_map.GetSize() / sizeof(data_ptr_t);
+		auto current_capacity = hash_map.GetSize() / sizeof(hash_t);
 		if (capacity > current_capacity) {
 			// Need more space
-			hash_map = buffer_manager.GetBufferAllocator().Allocate(capacity * sizeof(data_ptr_t));
+			hash_map = buffer_manager.GetBufferAllocator().Allocate(capacity * sizeof(hash_t));
 		} else {
 			// Just use the current hash map
 			capacity = current_capacity;
 		}
 	} else {
 		// Allocate a hash map
-		hash_map = buffer_manager.GetBufferAllocator().Allocate(capacity * sizeof(data_ptr_t));
+		hash_map = buffer_manager.GetBufferAllocator().Allocate(capacity * sizeof(hash_t));
 	}
-	D_ASSERT(hash_map.GetSize() == capacity * sizeof(data_ptr_t));
+	D_ASSERT(hash_map.GetSize() == capacity * sizeof(hash_t));
 
-	// initialize HT with all-zero entries
-	std::fill_n(reinterpret_cast<data_ptr_t *>(hash_map.get()), capacity, nullptr);
+	// initialize HT with all-zero entries (no pointer, empty tag)
+	std::fill_n(reinterpret_cast<hash_t *>(hash_map.get()), capacity, 0);
 
 	bitmask = capacity - 1;
+	bucket_shift = BucketShift(capacity);
+	if (external) {
+		// an external round only holds a few consecutive partitions, which would leave most of the pointer table
+		// empty if the position started with the radix bits, so it is taken from the bits below them instead
+		bucket_shift -= MinValue<idx_t>(radix_bits, bucket_shift);
+	}
 }
 
 void JoinHashTable::Finalize(idx_t chunk_idx_from, idx_t chunk_idx_to, bool parallel) {
@@ -336,22 +451,30 @@ void JoinHashTable::Finalize(idx_t chunk_idx_from, idx_t chunk_idx_to, bool para
 		for (idx_t i = 0; i < count; i++) {
 			hash_data[i] = Load<hash_t>(row_locations[i] + pointer_offset);
 		}
+		if (runtime_filter) {
+			runtime_filter->InsertHashes(hash_data, count);
+		}
 		InsertHashes(hashes, count, row_locations, parallel);
 	} while (iterator.Next());
 }
 
 unique_ptr<ScanStructure> JoinHashTable::InitializeScanStructure(DataChunk &keys, TupleDataChunkState &key_state,
+                                                                 DataChunk &buffer,
                                                                  const SelectionVector *&current_sel) {
 	D_ASSERT(Count() > 0);  // should be handled before
 	D_ASSERT(finalized);
 
 	// set up the scan structure
-	auto ss = make_uniq<ScanStructure>(*this, key_state, buffer_.get());
+	auto ss = make_uniq<ScanStructure>(*this, key_state, &buffer);
 
 	if (join_type != JoinType::INNER) {
 		ss->found_match = make_unsafe_uniq_array<bool>(STANDARD_VECTOR_SIZE);
 		memset(ss->found_match.get(), 0, sizeof(bool) * STANDARD_VECTOR_SIZE);
 	}
+	if (linear_probing) {
+		ss->slots = make_unsafe_uniq_array<idx_t>(STANDARD_VECTOR_SIZE);
+		ss->salts = make_unsafe_uniq_array<hash_t>(STANDARD_VECTOR_SIZE);
+	}
 
 	// first prepare the keys for probing
 	TupleDataCollection::ToUnifiedFormat(key_state, keys);
@@ -359,23 +482,23 @@ unique_ptr<ScanStructure> JoinHashTable::InitializeScanStructure(DataChunk &keys
 	return ss;
 }
 
-unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys, TupleDataChunkState &key_state,
+unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys, TupleDataChunkState &key_state, DataChunk &buffer,
                                                Vector *precomputed_hashes) {
 	const SelectionVector *current_sel;
-	auto ss = InitializeScanStructure(keys, key_state, current_sel);
+	auto ss = InitializeScanStructure(keys, key_state, buffer, current_sel);
 	if (ss->count == 0) {
 		return ss;
 	}
 
 	if (precomputed_hashes) {
-		ApplyBitmask(*precomputed_hashes, *current_sel, ss->count, ss->pointers);
+		GetChainHeads(*precomputed_hashes, *current_sel, ss->count, *ss);
 	} else {
 		// hash all the keys
 		Vector hashes(LogicalType::HASH);
 		Hash(keys, *current_sel, ss->count, hashes);
 
 		// now initialize the pointers of the scan structure based on the hashes
-		ApplyBitmask(hashes, *current_sel, ss->count, ss->pointers);
+		GetChainHeads(hashes, *current_sel, ss->count, *ss);
 	}
 
 	// create the selection vector linking to only non-empty entries
@@ -407,16 +530,16 @@ void ScanStructure::Next(DataChunk &keys, DataChunk &left, DataChunk &result) {
 			NextInnerJoin(keys, left, result);
 			break;
 		case JoinType::SEMI:
-			// [Logical Compaction] Semi join does not need compaction:
-			// Because (1) at most one Next() is called. (2) small chunks from different probing() cannot be compacted.
+			// [Logical Compaction] Semi join emits a single chunk per probe, so its (often sparse) results are
+			// compacted across probes by the CompactingPhysicalOperator once the probe is finished.
 			NextSemiJoin(keys, left, result);
 			break;
 		case JoinType::MARK:
-			// [Logical Compaction] Mark join does not need compaction for the same reasons.
+			// [Logical Compaction] Mark join emits one row per probe row, so its chunks are as full as the input.
 			NextMarkJoin(keys, left, result);
 			break;
 		case JoinType::ANTI:
-			// [Logical Compaction] Anti join does not need compaction for the same reasons.
+			// [Logical Compaction] Anti join is compacted across probes like the semi join.
 			NextAntiJoin(keys, left, result);
 			break;
 		case JoinType::OUTER:
@@ -425,7 +548,7 @@ void ScanStructure::Next(DataChunk &keys, DataChunk &left, DataChunk &result) {
 			NextLeftJoin(keys, left, result);
 			break;
 		case JoinType::SINGLE:
-			// [Logical Compaction] Single join does not need compaction for the same reasons.
+			// [Logical Compaction] Single join emits one row per probe row, like the mark join.
 			NextSingleJoin(keys, left, result);
 			break;
 		default:
@@ -472,11 +595,38 @@ void ScanStructure::AdvancePointers(const SelectionVector &sel, idx_t sel_count)
 	// now for all the pointers, we move on to the next set of pointers
 	idx_t new_count = 0;
 	auto ptrs = FlatVector::GetData<data_ptr_t>(this->pointers);
-	for (idx_t i = 0; i < sel_count; i++) {
-		auto idx = sel.get_index(i);
-		ptrs[idx] = Load<data_ptr_t>(ptrs[idx] + ht.pointer_offset);
-		if (ptrs[idx]) {
-			this->sel_vector.set_index(new_count++, idx);
+	if (ht.linear_probing) {
+		// move on to the next slot whose salt matches
+		auto entries = reinterpret_cast<hash_t *>(ht.hash_map.get());
+		for (idx_t i = 0; i < sel_count; i++) {
+			auto idx = sel.get_index(i);
+			idx_t slot = (slots[idx] + 1) & ht.bitmask;
+			ptrs[idx] = FindSaltMatch(entries, ht.bitmask, salts[idx], slot);
+			slots[idx] = slot;
+			if (ptrs[idx]) {
+				if (ht.prefetch_probe) {
+					PrefetchAddress(ptrs[idx]);
+				}
+				this->sel_vector.set_index(new_count++, idx);
+			}
+		}
+	} else if (ht.prefetch_probe) {
+		// the next tuples of all chains are prefetched before their keys are compared
+		for (idx_t i = 0; i < sel_count; i++) {
+			auto idx = sel.get_index(i);
+			ptrs[idx] = Load<data_ptr_t>(ptrs[idx] + ht.pointer_offset);
+			if (ptrs[idx]) {
+				PrefetchAddress(ptrs[idx]);
+				this->sel_vector.set_index(new_count++, idx);
+			}
+		}
+	} else {
+		for (idx_t i = 0; i < sel_count; i++) {
+			auto idx = sel.get_index(i);
+			ptrs[idx] = Load<data_ptr_t>(ptrs[idx] + ht.pointer_offset);
+			if (ptrs[idx]) {
+				this->sel_vector.set_index(new_count++, idx);
+			}
 		}
 	}
 	this->count = new_count;
@@ -488,7 +638,6 @@ void ScanStructure::InitializeSelectionVector(const SelectionVector *&current_se
 	auto cnt = count;
 	for (idx_t i = 0; i < cnt; i++) {
 		const auto idx = current_sel->get_index(i);
-		ptrs[idx] = Load<data_ptr_t>(ptrs[idx]);
 		if (ptrs[idx]) {
 			sel_vector.set_index(non_empty_count++, idx);
 		}
@@ -510,12 +659,82 @@ void ScanStructure::GatherResult(Vector &result, const SelectionVector &sel_vect
 	GatherResult(result, target_vector, sel_vector, count, col_idx);
 }
 
+JoinFilterState::JoinFilterState(ClientContext &context, const Expression &filter,
+                                 const vector<LogicalType> &result_types, const vector<bool> &build_columns)
+    : executor(context, filter), sel(STANDARD_VECTOR_SIZE), match_sel(STANDARD_VECTOR_SIZE),
+      build_columns(build_columns) {
+	chunk.Initialize(Allocator::Get(context), result_types);
+}
+
+idx_t ScanStructure::ResolveFilter(DataChunk &left, SelectionVector &result_vector, idx_t result_count) {
+	auto &chunk = filter_state->chunk;
+	chunk.Reset();
+	chunk.Slice(left, result_vector, result_count);
+	for (idx_t i = 0; i < ht.build_types.size(); i++) {
+		auto &vector = chunk.data[left.ColumnCount() + i];
+		if (filter_state->build_columns[i]) {
+			GatherResult(vector, *FlatVector::IncrementalSelectionVector(), result_vector, result_count,
+			             i + ht.condition_types.size());
+		} else {
+			// the filter does not read this column
+			vector.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(vector, true);
+		}
+	}
+	chunk.SetCardinality(result_count);
+
+	auto &sel = filter_state->sel;
+	auto filter_count = filter_state->executor.SelectExpression(chunk, sel);
+	// the selection of a disjunction is not ascending, so the matches that pass cannot be moved to the front in place
+	auto &match_sel = filter_state->match_sel;
+	for (idx_t i = 0; i < filter_count; i++) {
+		match_sel.set_index(i, result_vector.get_index(sel.get_index(i)));
+	}
+	for (idx_t i = 0; i < filter_count; i++) {
+		result_vector.set_index(i, match_sel.get_index(i));
+	}
+	return filter_count;
+}
+
+//! Copies the rows of a build column that ResolveFilter already gathered for the filter into the result. Gathered
+//! strings point into the hash table, so the strings are not copied again.
+static void CopyFilterColumn(Vector &source, const SelectionVector &sel, idx_t count, Vector &target,
+                             idx_t target_offset) {
+	if (source.GetType().InternalType() != PhysicalType::VARCHAR) {
+		VectorOperations::Copy(source, target, sel, count, 0, target_offset);
+		return;
+	}
+	D_ASSERT(source.GetVectorType() == VectorType::FLAT_VECTOR);
+	auto source_data = FlatVector::GetData<string_t>(source);
+	auto &source_validity = FlatVector::Validity(source);
+	auto target_data = FlatVector::GetData<string_t>(target);
+	auto &target_validity = FlatVector::Validity(target);
+	for (idx_t i = 0; i < count; i++) {
+		auto source_idx = sel.get_index(i);
+		if (source_validity.RowIsValid(source_idx)) {
+			target_data[target_offset + i] = source_data[source_idx];
+			target_validity.SetValid(target_offset + i);
+		} else {
+			target_validity.SetInvalid(target_offset + i);
+		}
+	}
+}
+
 void ScanStructure::NextInnerJoin(DataChunk &keys, DataChunk &left, DataChunk &result) {
 	D_ASSERT(result.ColumnCount() == left.ColumnCount() + ht.build_types.size());
+	D_ASSERT(!filter_state || ht.join_type == JoinType::INNER);
 
 	while (this->count > 0 && !HasBuffer()) {
 		SelectionVector result_vector(STANDARD_VECTOR_SIZE);
 		idx_t result_count = ScanInnerJoin(keys, result_vector);
+		if (result_count > 0 && filter_state) {
+			// late materialization: only the matches that pass the filter gather the other build columns
+			result_count = ResolveFilter(left, result_vector, result_count);
+			if (result_count == 0) {
+				AdvancePointers();
+				continue;
+			}
+		}
 		if (result_count > 0) {
 			// yiqiao: I am not sure if it works.
 			if (IsRightOuterJoin(ht.join_type)) {
@@ -556,7 +775,13 @@ void ScanStructure::NextInnerJoin(DataChunk &keys, DataChunk &left, DataChunk &r
 			for (idx_t i = 0; i < ht.build_types.size(); i++) {
 				auto &vector = res_chunk->data[left.ColumnCount() + i];
 				D_ASSERT(vector.GetType() == ht.build_types[i]);
-				GatherResult(vector, result_vector, result_count, i + ht.condition_types.size());
+				if (filter_state && filter_state->build_columns[i]) {
+					// the filter already gathered this column
+					CopyFilterColumn(filter_state->chunk.data[left.ColumnCount() + i], filter_state->sel, result_count,
+					                 vector, base_count);
+				} else {
+					GatherResult(vector, result_vector, result_count, i + ht.condition_types.size());
+				}
 			}
 
 			AdvancePointers();
@@ -821,34 +1046,49 @@ void ScanStructure::NextSingleJoin(DataChunk &keys, DataChunk &input, DataChunk
 }
 
 void JoinHashTable::ScanFullOuter(JoinHTScanState &state, Vector &addresses, DataChunk &result) {
+	auto found_entries = ScanFullOuterAddresses(state, addresses, 0);
+	GatherFullOuter(addresses, found_entries, result);
+}
+
+idx_t JoinHashTable::ScanFullOuterAddresses(JoinHTScanState &state, Vector &addresses, idx_t found_entries) {
+	D_ASSERT(found_entries < STANDARD_VECTOR_SIZE);
 	// scan the HT starting from the current position and check which rows from the build side did not find a match
 	auto key_locations = FlatVector::GetData<data_ptr_t>(addresses);
-	idx_t found_entries = 0;
 
 	auto &iterator = state.iterator;
 	if (iterator.Done()) {
-		return;
+		return found_entries;
 	}
 
 	const auto row_locations = iterator.GetRowLocations();
 	do {
 		const auto count = iterator.GetCurrentChunkCount();
-		for (idx_t i = state.offset_in_chunk; i < count; i++) {
-			auto found_match = Load<bool>(row_locations[i] + tuple_size);
-			if (!found_match) {
-				key_locations[found_entries++] = row_locations[i];
-				if (found_entries == STANDARD_VECTOR_SIZE) {
-					state.offset_in_chunk = i + 1;
-					break;
+		idx_t i = state.offset_in_chunk;
+		if (count - i <= STANDARD_VECTOR_SIZE - found_entries) {
+			// the remaining rows of the chunk fit, so we can write every row and only advance past the unmatched ones
+			for (; i < count; i++) {
+				key_locations[found_entries] = row_locations[i];
+				found_entries += !Load<bool>(row_locations[i] + tuple_size);
+			}
+		} else {
+			for (; i < count; i++) {
+				if (!Load<bool>(row_locations[i] + tuple_size)) {
+					key_locations[found_entries++] = row_locations[i];
+					if (found_entries == STANDARD_VECTOR_SIZE) {
+						// resume the scan after this row
+						state.offset_in_chunk = i + 1;
+						return found_entries;
+					}
 				}
 			}
 		}
-		if (found_entries == STANDARD_VECTOR_SIZE) {
-			break;
-		}
 		state.offset_in_chunk = 0;
-	} while (iterator.Next());
+	} while (iterator.Next() && found_entries < STANDARD_VECTOR_SIZE);
 
+	return found_entries;
+}
+
+void JoinHashTable::GatherFullOuter(Vector &addresses, idx_t found_entries, DataChunk &result) {
 	// now gather from the found rows
 	if (found_entries == 0) {
 		return;
@@ -918,9 +1158,19 @@ bool JoinHashTable::RequiresExternalJoin(ClientConfig &config, vector<unique_ptr
 }
 
 void JoinHashTable::Unpartition() {
+	// the partitions are appended in order, so that every partition is a contiguous range of chunks
+	partition_chunk_offsets.clear();
 	for (auto &partition : sink_collection->GetPartitions()) {
+		partition_chunk_offsets.push_back(data_collection->ChunkCount());
 		data_collection->Combine(*partition);
 	}
+	partition_chunk_offsets.push_back(data_collection->ChunkCount());
+}
+
+bool JoinHashTable::CanFinalizePartitioned() const {
+	// with linear probing, the probe sequence of an entry can continue into the range of the next partition
+	return !linear_probing && !external && !partition_chunk_offsets.empty() &&
+	       bitmask + 1 >= RadixPartitioning::NumberOfPartitions(radix_bits);
 }
 
 bool JoinHashTable::RequiresPartitioning(ClientConfig &config, vector<unique_ptr<JoinHashTable>> &local_hts) {
@@ -997,7 +1247,16 @@ bool JoinHashTable::PrepareExternalFinalize() {
 		Reset();
 	}
 
+	if (resident_partitions.empty()) {
+		PrepareResidentPartitions();
+		return true;
+	}
+
+	// Skip the partitions that were in the HT during the first round
 	const auto num_partitions = RadixPartitioning::NumberOfPartitions(radix_bits);
+	while (partition_end < num_partitions && resident_partitions[partition_end]) {
+		partition_end++;
+	}
 	if (partition_end == num_partitions) {
 		return false;
 	}
@@ -1031,6 +1290,47 @@ bool JoinHashTable::PrepareExternalFinalize() {
 	return true;
 }
 
+void JoinHashTable::PrepareResidentPartitions() {
+	// The probe tuples of the partitions in the first round do not have to be spilled. Taking the smallest partitions
+	// that fit (rather than the first ones) keeps as many partitions as possible in the HT, so that only the probe
+	// tuples of the partitions that overflow the memory limit are spilled
+	auto &partitions = sink_collection->GetPartitions();
+	const auto num_partitions = partitions.size();
+	vector<idx_t> partition_order(num_partitions);
+	std::iota(partition_order.begin(), partition_order.end(), 0);
+	std::stable_sort(partition_order.begin(), partition_order.end(), [&](const idx_t &lhs, const idx_t &rhs) {
+		return partitions[lhs]->SizeInBytes() < partitions[rhs]->SizeInBytes();
+	});
+
+	// Determine which partitions we can keep (at least one)
+	resident_partitions.resize(num_partitions, false);
+	idx_t count = 0;
+	idx_t data_size = 0;
+	for (auto &partition_idx : partition_order) {
+		auto incl_count = count + partitions[partition_idx]->Count();
+		auto incl_data_size = data_size + partitions[partition_idx]->SizeInBytes();
+		auto incl_ht_size = incl_data_size + PointerTableSize(incl_count);
+		if (count > 0 && incl_ht_size > max_ht_size) {
+			continue;
+		}
+		count = incl_count;
+		data_size = incl_data_size;
+		resident_partitions[partition_idx] = true;
+	}
+
+	// Move the partitions to the main data collection
+	for (idx_t partition_idx = 0; partition_idx < num_partitions; partition_idx++) {
+		if (resident_partitions[partition_idx]) {
+			data_collection->Combine(*partitions[partition_idx]);
+		}
+	}
+	D_ASSERT(Count() == count);
+
+	// The later rounds take the remaining partitions in order
+	partition_start = 0;
+	partition_end = 0;
+}
+
 static void CreateSpillChunk(DataChunk &spill_chunk, DataChunk &keys, DataChunk &payload, Vector &hashes) {
 	spill_chunk.Reset();
 	idx_t spill_col_idx = 0;
@@ -1046,7 +1346,7 @@ static void CreateSpillChunk(DataChunk &spill_chunk, DataChunk &keys, DataChunk
 }
 
 unique_ptr<ScanStructure> JoinHashTable::ProbeAndSpill(DataChunk &keys, TupleDataChunkState &key_state,
-                                                       DataChunk &payload, ProbeSpill &probe_spill,
+                                                       DataChunk &buffer, DataChunk &payload, ProbeSpill &probe_spill,
                                                        ProbeSpillLocalAppendState &spill_state,
                                                        DataChunk &spill_chunk) {
 	// hash all the keys
@@ -1059,7 +1359,7 @@ unique_ptr<ScanStructure> JoinHashTable::ProbeAndSpill(DataChunk &keys, TupleDat
 	true_sel.Initialize();
 	false_sel.Initialize();
 	auto true_count = RadixPartitioning::Select(hashes, FlatVector::IncrementalSelectionVector(), keys.size(),
-	                                            radix_bits, partition_end, &true_sel, &false_sel);
+	                                            radix_bits, resident_partitions, &true_sel, &false_sel);
 	auto false_count = keys.size() - true_count;
 
 	CreateSpillChunk(spill_chunk, keys, payload, hashes);
@@ -1075,13 +1375,13 @@ unique_ptr<ScanStructure> JoinHashTable::ProbeAndSpill(DataChunk &keys, TupleDat
 	payload.Slice(true_sel, true_count);
 
 	const SelectionVector *current_sel;
-	auto ss = InitializeScanStructure(keys, key_state, current_sel);
+	auto ss = InitializeScanStructure(keys, key_state, buffer, current_sel);
 	if (ss->count == 0) {
 		return ss;
 	}
 
 	// now initialize the pointers of the scan structure based on the hashes
-	ApplyBitmask(hashes, *current_sel, ss->count, ss->pointers);
+	GetChainHeads(hashes, *current_sel, ss->count, *ss);
 
 	// create the selection vector linking to only non-empty entries
 	ss->InitializeSelectionVector(current_sel);
@@ -1,5 +1,9 @@
 #include "duckdb/execution/operator/helper/physical_pipeline_breaker.hpp"
 
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/join_hashtable.hpp"
+
 #include "../extension/jemalloc/include/jemalloc_extension.hpp"
 
 namespace duckdb {
@@ -13,12 +17,24 @@ PhysicalPipelineBreaker::PhysicalPipelineBreaker(vector<LogicalType> types, uniq
 PhysicalPipelineBreaker::~PhysicalPipelineBreaker() {
 }
 
+idx_t PhysicalPipelineBreaker::PartitionCount() const {
+	if (reorder_keys.empty()) {
+		return 1;
+	}
+	return MinValue<idx_t>(idx_t(1) << REORDER_RADIX_BITS, reorder_capacity);
+}
+
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
 class PipelineBreakerGlobalState : public GlobalSinkState {
 public:
+	explicit PipelineBreakerGlobalState(idx_t partition_count) : partitions(partition_count) {
+	}
+
 	std::mutex glock;
+	//! The rows of every partition, combined from all threads
+	vector<unique_ptr<ColumnDataCollection>> partitions;
 	shared_ptr<ColumnDataCollection> intermediate_table;
 	ColumnDataParallelScanState scan_state;
 	bool initialized = false;
@@ -26,22 +42,90 @@ public:
 
 class PipelineBreakerLocalState : public LocalSinkState {
 public:
-	explicit PipelineBreakerLocalState(vector<LogicalType> types, ClientContext &context) {
-		intermediate_table = make_uniq<ColumnDataCollection>(Allocator::DefaultAllocator(), types);
-		intermediate_table->InitializeAppend(append_state);
+	PipelineBreakerLocalState(const PhysicalPipelineBreaker &op, ClientContext &context)
+	    : executor(context), hashes(LogicalType::HASH), partition_sel(STANDARD_VECTOR_SIZE) {
+		auto partition_count = op.PartitionCount();
+		partitions.resize(partition_count);
+		append_states.resize(partition_count);
+		for (idx_t i = 0; i < partition_count; i++) {
+			partitions[i] = make_uniq<ColumnDataCollection>(Allocator::DefaultAllocator(), op.types);
+			partitions[i]->InitializeAppend(append_states[i]);
+		}
+		if (!op.reorder_keys.empty()) {
+			vector<LogicalType> key_types;
+			for (auto &key : op.reorder_keys) {
+				executor.AddExpression(*key);
+				key_types.push_back(key->return_type);
+			}
+			keys.Initialize(Allocator::Get(context), key_types);
+			partition_chunk.InitializeEmpty(op.types);
+		}
 	}
 
-	unique_ptr<ColumnDataCollection> intermediate_table;
-	ColumnDataAppendState append_state;
+	vector<unique_ptr<ColumnDataCollection>> partitions;
+	vector<ColumnDataAppendState> append_states;
+
+	//! Evaluates the join keys the rows are reordered by
+	ExpressionExecutor executor;
+	DataChunk keys;
+	Vector hashes;
+	//! The rows of the input chunk, grouped by partition
+	SelectionVector partition_sel;
+	DataChunk partition_chunk;
 };
 
+//! Appends the rows of the chunk to the partition of the pointer table region their join key hashes to
+static void AppendPartitioned(const PhysicalPipelineBreaker &op, PipelineBreakerLocalState &lstate,
+                              DataChunk &chunk) {
+	auto count = chunk.size();
+	lstate.keys.Reset();
+	lstate.executor.Execute(chunk, lstate.keys);
+	VectorOperations::Hash(lstate.keys.data[0], lstate.hashes, count);
+	for (idx_t i = 1; i < lstate.keys.ColumnCount(); i++) {
+		VectorOperations::CombineHash(lstate.hashes, lstate.keys.data[i], count);
+	}
+	lstate.hashes.Flatten(count);
+	auto hash_data = FlatVector::GetData<hash_t>(lstate.hashes);
+
+	// the partition is given by the upper bits of the pointer table entry of a row, which are the same bits of the
+	// hash for any capacity of the pointer table
+	auto partition_count = lstate.partitions.size();
+	auto shift = JoinHashTable::BucketShift(partition_count);
+	auto mask = partition_count - 1;
+	vector<idx_t> offsets(partition_count + 1, 0);
+	for (idx_t i = 0; i < count; i++) {
+		offsets[((hash_data[i] >> shift) & mask) + 1]++;
+	}
+	for (idx_t p = 0; p < partition_count; p++) {
+		offsets[p + 1] += offsets[p];
+	}
+	vector<idx_t> positions(offsets.begin(), offsets.end() - 1);
+	for (idx_t i = 0; i < count; i++) {
+		lstate.partition_sel.set_index(positions[(hash_data[i] >> shift) & mask]++, i);
+	}
+
+	for (idx_t p = 0; p < partition_count; p++) {
+		auto partition_size = offsets[p + 1] - offsets[p];
+		if (partition_size == 0) {
+			continue;
+		}
+		SelectionVector sel(lstate.partition_sel.data() + offsets[p]);
+		lstate.partition_chunk.Slice(chunk, sel, partition_size);
+		lstate.partitions[p]->Append(lstate.append_states[p], lstate.partition_chunk);
+	}
+}
+
 duckdb::SinkResultType PhysicalPipelineBreaker::Sink(duckdb::ExecutionContext &context, duckdb::DataChunk &chunk,
                                                      duckdb::OperatorSinkInput &input) const {
 	auto &lstate = input.local_state.Cast<PipelineBreakerLocalState>();
 
 	Profiler profiler;
 	profiler.Start();
-	{ lstate.intermediate_table->Append(lstate.append_state, chunk); }
+	if (reorder_keys.empty()) {
+		lstate.partitions[0]->Append(lstate.append_states[0], chunk);
+	} else {
+		AppendPartitioned(*this, lstate, chunk);
+	}
 	BeeProfiler::Get().InsertStatRecord("[PhysicalPipelineBreaker::Sink] append", profiler.Elapsed());
 	return SinkResultType::NEED_MORE_INPUT;
 }
@@ -51,15 +135,17 @@ SinkCombineResultType PhysicalPipelineBreaker::Combine(ExecutionContext &context
 	auto &gstate = input.global_state.Cast<PipelineBreakerGlobalState>();
 	auto &lstate = input.local_state.Cast<PipelineBreakerLocalState>();
 
-	if (lstate.intermediate_table->Count() == 0) {
-		return SinkCombineResultType::FINISHED;
-	}
-
 	lock_guard<mutex> l(gstate.glock);
-	if (!gstate.intermediate_table) {
-		gstate.intermediate_table = std::move(lstate.intermediate_table);
-	} else {
-		gstate.intermediate_table->Combine(*lstate.intermediate_table);
+	for (idx_t p = 0; p < lstate.partitions.size(); p++) {
+		auto &partition = lstate.partitions[p];
+		if (partition->Count() == 0) {
+			continue;
+		}
+		if (!gstate.partitions[p]) {
+			gstate.partitions[p] = std::move(partition);
+		} else {
+			gstate.partitions[p]->Combine(*partition);
+		}
 	}
 
 	return SinkCombineResultType::FINISHED;
@@ -68,15 +154,28 @@ SinkCombineResultType PhysicalPipelineBreaker::Combine(ExecutionContext &context
 SinkFinalizeType PhysicalPipelineBreaker::Finalize(duckdb::Pipeline &pipeline, duckdb::Event &event,
                                                    duckdb::ClientContext &context,
                                                    duckdb::OperatorSinkFinalizeInput &input) const {
+	auto &gstate = input.global_state.Cast<PipelineBreakerGlobalState>();
+	// concatenate the partitions, so that the rows are scanned partition by partition
+	for (auto &partition : gstate.partitions) {
+		if (!partition) {
+			continue;
+		}
+		if (!gstate.intermediate_table) {
+			gstate.intermediate_table = std::move(partition);
+		} else {
+			gstate.intermediate_table->Combine(*partition);
+		}
+	}
+	gstate.partitions.clear();
 	return SinkFinalizeType::READY;
 }
 
 unique_ptr<GlobalSinkState> PhysicalPipelineBreaker::GetGlobalSinkState(ClientContext &context) const {
-	return make_uniq<PipelineBreakerGlobalState>();
+	return make_uniq<PipelineBreakerGlobalState>(PartitionCount());
 }
 
 unique_ptr<LocalSinkState> PhysicalPipelineBreaker::GetLocalSinkState(ExecutionContext &context) const {
-	return make_uniq<PipelineBreakerLocalState>(types, context.client);
+	return make_uniq<PipelineBreakerLocalState>(*this, context.client);
 }
 
 //===--------------------------------------------------------------------===//
@@ -85,11 +184,16 @@ unique_ptr<LocalSinkState> PhysicalPipelineBreaker::GetLocalSinkState(ExecutionC
 class PipelineBreakerSourceState : public LocalSourceState {
 public:
 	ColumnDataLocalScanState local_scan_state;
+	//! The chunk last scanned from the collection, and the offset of its first row that has not been emitted yet
+	DataChunk scan_chunk;
+	idx_t scan_offset = 0;
 };
 
 unique_ptr<LocalSourceState> PhysicalPipelineBreaker::GetLocalSourceState(duckdb::ExecutionContext &context,
                                                                           GlobalSourceState &gstate) const {
-	return make_uniq<PipelineBreakerSourceState>();
+	auto result = make_uniq<PipelineBreakerSourceState>();
+	result->scan_chunk.Initialize(Allocator::Get(context.client), types);
+	return std::move(result);
 }
 
 SourceResultType PhysicalPipelineBreaker::GetData(ExecutionContext &context, DataChunk &chunk,
@@ -97,6 +201,10 @@ SourceResultType PhysicalPipelineBreaker::GetData(ExecutionContext &context, Dat
 	auto &sink = sink_state->Cast<PipelineBreakerGlobalState>();
 	auto &lstate = input.local_state.Cast<PipelineBreakerSourceState>();
 
+	if (!sink.intermediate_table) {
+		// no rows were sunk
+		return SourceResultType::FINISHED;
+	}
 	if (!sink.initialized) {
 		lock_guard<mutex> lock(sink.glock);
 		if (!sink.initialized) {
@@ -105,10 +213,30 @@ SourceResultType PhysicalPipelineBreaker::GetData(ExecutionContext &context, Dat
 		}
 	}
 
-	//	Profiler profiler;
-	//	profiler.Start();
-	sink.intermediate_table->Scan(sink.scan_state, lstate.local_scan_state, chunk);
-	// BeeProfiler::Get().InsertStatRecord("[PhysicalPipelineBreaker::GetData] scan", profiler.Elapsed());
+	// the collection holds a partially filled chunk per thread and partition: re-chunk them into full chunks
+	auto &scan_chunk = lstate.scan_chunk;
+	while (chunk.size() < STANDARD_VECTOR_SIZE) {
+		if (lstate.scan_offset >= scan_chunk.size()) {
+			scan_chunk.Reset();
+			lstate.scan_offset = 0;
+			if (!sink.intermediate_table->Scan(sink.scan_state, lstate.local_scan_state, scan_chunk)) {
+				break;
+			}
+			if (chunk.size() == 0 && scan_chunk.size() == STANDARD_VECTOR_SIZE) {
+				// full chunk: emit it without copying
+				chunk.Reference(scan_chunk);
+				lstate.scan_offset = scan_chunk.size();
+				break;
+			}
+		}
+		auto append_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE - chunk.size(), scan_chunk.size() - lstate.scan_offset);
+		for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+			VectorOperations::Copy(scan_chunk.data[col_idx], chunk.data[col_idx], lstate.scan_offset + append_count,
+			                       lstate.scan_offset, chunk.size());
+		}
+		chunk.SetCardinality(chunk.size() + append_count);
+		lstate.scan_offset += append_count;
+	}
 
 	return chunk.size() == 0 ? SourceResultType::FINISHED : SourceResultType::HAVE_MORE_OUTPUT;
 }
@@ -0,0 +1,85 @@
+#include "duckdb/execution/operator/join/join_hashtable_cache.hpp"
+
+#include "duckdb/execution/join_hashtable.hpp"
+#include "duckdb/storage/table/data_table_info.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+
+namespace duckdb {
+
+JoinHashTableCache &JoinHashTableCache::Get(ClientContext &context) {
+	auto &cache = ObjectCache::GetObjectCache(context);
+	return *cache.GetOrCreate<JoinHashTableCache>(ObjectType());
+}
+
+bool JoinHashTableCache::GetTableVersions(ClientContext &context, const vector<shared_ptr<DataTableInfo>> &tables,
+                                          vector<transaction_t> &versions) {
+	versions.clear();
+	for (auto &table : tables) {
+		auto &transaction = DuckTransaction::Get(context, table->db);
+		if (transaction.ChangesMade()) {
+			// the transaction may see its own changes to the table
+			return false;
+		}
+		transaction_t version = table->last_commit_id;
+		if (version >= transaction.start_time) {
+			// the transaction does not see the latest change to the table
+			return false;
+		}
+		versions.push_back(version);
+	}
+	return true;
+}
+
+shared_ptr<CachedJoinHashTable> JoinHashTableCache::Lookup(const string &key,
+                                                           const vector<shared_ptr<DataTableInfo>> &tables,
+                                                           const vector<transaction_t> &versions) {
+	D_ASSERT(tables.size() == versions.size());
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	auto &cached = *entry->second;
+	bool unchanged = cached.tables.size() == tables.size();
+	for (idx_t table_idx = 0; unchanged && table_idx < tables.size(); table_idx++) {
+		unchanged = cached.tables[table_idx].lock() == tables[table_idx] &&
+		            cached.versions[table_idx] == versions[table_idx];
+	}
+	if (!unchanged) {
+		// one of the tables was changed (or dropped) since the hash table was built: it is never used again
+		memory_usage -= cached.size;
+		entries.erase(entry);
+		return nullptr;
+	}
+	cached.last_use = ++use_count;
+	return entry->second;
+}
+
+void JoinHashTableCache::Insert(const string &key, shared_ptr<CachedJoinHashTable> entry, idx_t max_memory) {
+	if (entry->size > max_memory) {
+		return;
+	}
+	lock_guard<mutex> guard(lock);
+	auto existing = entries.find(key);
+	if (existing != entries.end()) {
+		// another query built the same hash table concurrently (or over other versions of the tables)
+		memory_usage -= existing->second->size;
+		entries.erase(existing);
+	}
+	while (memory_usage + entry->size > max_memory) {
+		auto lru = entries.begin();
+		for (auto it = entries.begin(); it != entries.end(); it++) {
+			if (it->second->last_use < lru->second->last_use) {
+				lru = it;
+			}
+		}
+		// queries that are still probing an evicted hash table keep it alive until they are done
+		memory_usage -= lru->second->size;
+		entries.erase(lru);
+	}
+	entry->last_use = ++use_count;
+	memory_usage += entry->size;
+	entries[key] = std::move(entry);
+}
+
+} // namespace duckdb
@@ -0,0 +1,154 @@
+#include "duckdb/execution/operator/join/join_runtime_filter.hpp"
+
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+
+namespace duckdb {
+
+JoinRuntimeFilter::JoinRuntimeFilter(vector<LogicalType> key_types_p, vector<idx_t> scan_columns_p)
+    : key_types(std::move(key_types_p)), scan_columns(std::move(scan_columns_p)), enabled(false), block_mask(0) {
+	D_ASSERT(key_types.size() == scan_columns.size());
+	for (auto &type : key_types) {
+		min_values.emplace_back(type);
+		max_values.emplace_back(type);
+	}
+}
+
+void JoinRuntimeFilter::Reset() {
+	enabled = false;
+	for (idx_t key_idx = 0; key_idx < key_types.size(); key_idx++) {
+		min_values[key_idx] = Value(key_types[key_idx]);
+		max_values[key_idx] = Value(key_types[key_idx]);
+	}
+	blocks.reset();
+	block_mask = 0;
+}
+
+void JoinRuntimeFilter::Enable() {
+	enabled = true;
+}
+
+bool JoinRuntimeFilter::SupportsRange(const LogicalType &type) {
+	return type.IsIntegral();
+}
+
+template <class T>
+static void TemplatedUpdateRange(BaseStatistics &range, Vector &keys, idx_t count) {
+	UnifiedVectorFormat kdata;
+	keys.ToUnifiedFormat(count, kdata);
+
+	auto data = UnifiedVectorFormat::GetData<T>(kdata);
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = kdata.sel->get_index(i);
+		if (kdata.validity.RowIsValid(idx)) {
+			NumericStats::Update<T>(range, data[idx]);
+		}
+	}
+}
+
+void JoinRuntimeFilter::UpdateRange(BaseStatistics &range, Vector &keys, idx_t count) {
+	switch (keys.GetType().InternalType()) {
+	case PhysicalType::INT8:
+		TemplatedUpdateRange<int8_t>(range, keys, count);
+		break;
+	case PhysicalType::INT16:
+		TemplatedUpdateRange<int16_t>(range, keys, count);
+		break;
+	case PhysicalType::INT32:
+		TemplatedUpdateRange<int32_t>(range, keys, count);
+		break;
+	case PhysicalType::INT64:
+		TemplatedUpdateRange<int64_t>(range, keys, count);
+		break;
+	case PhysicalType::UINT8:
+		TemplatedUpdateRange<uint8_t>(range, keys, count);
+		break;
+	case PhysicalType::UINT16:
+		TemplatedUpdateRange<uint16_t>(range, keys, count);
+		break;
+	case PhysicalType::UINT32:
+		TemplatedUpdateRange<uint32_t>(range, keys, count);
+		break;
+	case PhysicalType::UINT64:
+		TemplatedUpdateRange<uint64_t>(range, keys, count);
+		break;
+	case PhysicalType::INT128:
+		TemplatedUpdateRange<hugeint_t>(range, keys, count);
+		break;
+	default:
+		throw InternalException("Unsupported type for JoinRuntimeFilter::UpdateRange");
+	}
+}
+
+void JoinRuntimeFilter::SetRange(idx_t key_idx, const BaseStatistics &range) {
+	D_ASSERT(SupportsRange(key_types[key_idx]));
+	// an empty range (min > max) rejects every probe key, which is correct as no build key can match
+	min_values[key_idx] = NumericStats::Min(range);
+	max_values[key_idx] = NumericStats::Max(range);
+}
+
+void JoinRuntimeFilter::InitializeBloomFilter(idx_t count) {
+	auto block_count = NextPowerOfTwo(MaxValue<idx_t>(count * BITS_PER_KEY / 64, 1));
+	block_count = MinValue<idx_t>(block_count, MAX_BLOCK_COUNT);
+	// zero-initialized
+	blocks = make_unsafe_uniq_array<atomic<uint64_t>>(block_count);
+	block_mask = block_count - 1;
+}
+
+void JoinRuntimeFilter::InsertHashes(const hash_t hashes[], idx_t count) {
+	D_ASSERT(blocks);
+	for (idx_t i = 0; i < count; i++) {
+		blocks[hashes[i] & block_mask].fetch_or(BloomBits(hashes[i]), std::memory_order_relaxed);
+	}
+}
+
+idx_t JoinRuntimeFilter::Select(DataChunk &chunk, Vector &hashes, SelectionVector &sel) const {
+	D_ASSERT(enabled);
+	idx_t count = chunk.size();
+	const SelectionVector *current_sel = FlatVector::IncrementalSelectionVector();
+
+	// first check the ranges, this also removes NULL keys
+	for (idx_t key_idx = 0; key_idx < key_types.size() && count > 0; key_idx++) {
+		if (min_values[key_idx].IsNull()) {
+			continue;
+		}
+		auto &keys = chunk.data[scan_columns[key_idx]];
+		Vector min_vector(min_values[key_idx]);
+		if (current_sel == &sel) {
+			// the comparisons only map their output through the selection, slice the keys to read the selected rows
+			Vector sliced_keys(keys, sel, count);
+			count = VectorOperations::GreaterThanEquals(sliced_keys, min_vector, &sel, count, &sel, nullptr);
+		} else {
+			count = VectorOperations::GreaterThanEquals(keys, min_vector, current_sel, count, &sel, nullptr);
+			current_sel = &sel;
+		}
+		Vector sliced_keys(keys, sel, count);
+		Vector max_vector(max_values[key_idx]);
+		count = VectorOperations::LessThanEquals(sliced_keys, max_vector, &sel, count, &sel, nullptr);
+	}
+	if (!blocks || count == 0) {
+		return count;
+	}
+
+	// then probe the Bloom filter with the same hash as the hash table
+	VectorOperations::Hash(chunk.data[scan_columns[0]], hashes, *current_sel, count);
+	for (idx_t key_idx = 1; key_idx < key_types.size(); key_idx++) {
+		VectorOperations::CombineHash(hashes, chunk.data[scan_columns[key_idx]], *current_sel, count);
+	}
+	UnifiedVectorFormat hdata;
+	hashes.ToUnifiedFormat(chunk.size(), hdata);
+	auto hash_data = UnifiedVectorFormat::GetData<hash_t>(hdata);
+
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = current_sel->get_index(i);
+		auto hash = hash_data[hdata.sel->get_index(idx)];
+		auto bits = BloomBits(hash);
+		auto block = blocks[hash & block_mask].load(std::memory_order_relaxed);
+		sel.set_index(result_count, idx);
+		result_count += (block & bits) == bits;
+	}
+	return result_count;
+}
+
+} // namespace duckdb
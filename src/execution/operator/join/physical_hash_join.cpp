@@ -3,6 +3,7 @@
 #include "duckdb/common/negative_feedback.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/join/join_hashtable_cache.hpp"
 #include "duckdb/function/aggregate/distributive_functions.hpp"
 #include "duckdb/function/function_binder.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -13,7 +14,9 @@
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
 namespace duckdb {
@@ -48,13 +51,50 @@ PhysicalHashJoin::PhysicalHashJoin(LogicalOperator &op, unique_ptr<PhysicalOpera
                        estimated_cardinality, std::move(perfect_join_state)) {
 }
 
+static void GetFilterBuildColumns(const Expression &expr, idx_t probe_column_count, vector<bool> &build_columns) {
+	if (expr.type == ExpressionType::BOUND_REF) {
+		auto &ref = expr.Cast<BoundReferenceExpression>();
+		if (ref.index >= probe_column_count) {
+			build_columns[ref.index - probe_column_count] = true;
+		}
+	}
+	ExpressionIterator::EnumerateChildren(
+	    expr, [&](const Expression &child) { GetFilterBuildColumns(child, probe_column_count, build_columns); });
+}
+
+bool PhysicalHashJoin::AddFilter(unique_ptr<Expression> &expr) {
+	// a filter over the other join types would also have to drop the tuples that only it rejects from the found
+	// matches (or emit them with NULLs), so it is only taken over by inner joins
+	if (join_type != JoinType::INNER || filter || expr->HasSideEffects()) {
+		return false;
+	}
+	filter_build_columns.assign(build_types.size(), false);
+	GetFilterBuildColumns(*expr, children[0]->types.size(), filter_build_columns);
+	filter = std::move(expr);
+	return true;
+}
+
+string PhysicalHashJoin::ParamsToString() const {
+	auto result = PhysicalComparisonJoin::ParamsToString();
+	if (filter) {
+		result += "\n[INFOSEPARATOR]\n";
+		result += "Filter: " + filter->GetName();
+	}
+	if (perfect_join_statistics.is_build_small) {
+		// the probe falls back to the hash table if the build keys turn out not to be unique
+		result += "\n[INFOSEPARATOR]\n";
+		result += "Perfect Hash Join";
+	}
+	return result;
+}
+
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
 class HashJoinGlobalSinkState : public GlobalSinkState {
 public:
-	HashJoinGlobalSinkState(const PhysicalHashJoin &op, ClientContext &context_p)
-	    : context(context_p), finalized(false), scanned_data(false) {
+	HashJoinGlobalSinkState(const PhysicalHashJoin &op_p, ClientContext &context_p)
+	    : op(op_p), context(context_p), finalized(false), scanned_data(false) {
 		hash_table = op.InitializeHashTable(context);
 
 		// for perfect hash join
@@ -76,15 +116,30 @@ public:
 		string address = to_string(size_t(&hash_table)) + " - " + to_string(size_t(&op));
 		ht_name = conditions_str + " - " + address;
 		join_probe_name = "[HashJoin - (3) Probe Table - " + ht_name + "]";
+		// the runtime filter is only enabled once this build side is complete
+		if (op.runtime_filter) {
+			op.runtime_filter->Reset();
+			for (auto &key_type : op.runtime_filter->key_types) {
+				key_ranges.push_back(BaseStatistics::CreateEmpty(key_type));
+			}
+		}
+		// the build side is skipped if its hash table is cached, otherwise the hash table is cached once finalized
+		if (!op.cache_key.empty() && JoinHashTableCache::GetTableVersions(context, op.cache_tables, cache_versions)) {
+			cached_hash_table = JoinHashTableCache::Get(context).Lookup(op.cache_key, op.cache_tables, cache_versions);
+			cache_hash_table = !cached_hash_table;
+		}
 	}
 
 	void ScheduleFinalize(Pipeline &pipeline, Event &event);
 	void InitializeProbeSpill();
+	//! Adds the finalized hash table to the JoinHashTableCache (if it can be cached)
+	void CacheHashTable();
 
 public:
+	const PhysicalHashJoin &op;
 	ClientContext &context;
 	//! Global HT used by the join
-	unique_ptr<JoinHashTable> hash_table;
+	shared_ptr<JoinHashTable> hash_table;
 	//! yiqiao: hash table name
 	string ht_name;
 	string join_probe_name;
@@ -106,6 +161,16 @@ public:
 
 	//! Whether or not we have started scanning data using GetData
 	atomic<bool> scanned_data;
+
+	//! The range of every build key, for the runtime filter
+	vector<BaseStatistics> key_ranges;
+
+	//! The cached hash table that is used instead of building one (if any)
+	shared_ptr<CachedJoinHashTable> cached_hash_table;
+	//! Whether the hash table is added to the JoinHashTableCache once it is finalized
+	bool cache_hash_table = false;
+	//! The commit ids of the latest changes to the tables scanned by the build side (if the hash table is cached)
+	vector<transaction_t> cache_versions;
 };
 
 class HashJoinLocalSinkState : public LocalSinkState {
@@ -123,6 +188,12 @@ public:
 		hash_table = op.InitializeHashTable(context);
 
 		hash_table->GetSinkCollection().InitializeAppendState(append_state);
+
+		if (op.runtime_filter) {
+			for (auto &key_type : op.runtime_filter->key_types) {
+				key_ranges.push_back(BaseStatistics::CreateEmpty(key_type));
+			}
+		}
 	}
 
 public:
@@ -134,12 +205,16 @@ public:
 
 	//! Thread-local HT
 	unique_ptr<JoinHashTable> hash_table;
+	//! The range of every build key sunk by this thread, for the runtime filter
+	vector<BaseStatistics> key_ranges;
 };
 
 unique_ptr<JoinHashTable> PhysicalHashJoin::InitializeHashTable(ClientContext &context) const {
 	auto result =
 	    make_uniq<JoinHashTable>(BufferManager::GetBufferManager(context), conditions, build_types, join_type);
 	result->max_ht_size = double(0.6) * BufferManager::GetBufferManager(context).GetMaxMemory();
+	result->prefetch_probe = ClientConfig::GetConfig(context).enable_join_prefetch;
+	result->linear_probing = linear_probing;
 	if (!delim_types.empty() && join_type == JoinType::MARK) {
 		// correlated MARK join
 		if (delim_types.size() + 1 == conditions.size()) {
@@ -200,11 +275,24 @@ unique_ptr<LocalSinkState> PhysicalHashJoin::GetLocalSinkState(ExecutionContext
 SinkResultType PhysicalHashJoin::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
 	auto &lstate = input.local_state.Cast<HashJoinLocalSinkState>();
 	auto &sink = input.global_state.Cast<HashJoinGlobalSinkState>();
+	if (sink.cached_hash_table) {
+		// the hash table is cached: stop the build side
+		return SinkResultType::FINISHED;
+	}
 
 	// resolve the join keys for the right chunk
 	lstate.join_keys.Reset();
 	lstate.build_executor.Execute(chunk, lstate.join_keys);
 
+	if (runtime_filter) {
+		for (idx_t key_idx = 0; key_idx < lstate.key_ranges.size(); key_idx++) {
+			if (JoinRuntimeFilter::SupportsRange(runtime_filter->key_types[key_idx])) {
+				JoinRuntimeFilter::UpdateRange(lstate.key_ranges[key_idx], lstate.join_keys.data[key_idx],
+				                               lstate.join_keys.size());
+			}
+		}
+	}
+
 	// build the HT
 	auto &ht = *lstate.hash_table;
 	if (!right_projection_map.empty()) {
@@ -234,6 +322,9 @@ SinkCombineResultType PhysicalHashJoin::Combine(ExecutionContext &context, Opera
 		lstate.hash_table->GetSinkCollection().FlushAppendState(lstate.append_state);
 		lock_guard<mutex> local_ht_lock(gstate.lock);
 		gstate.local_hash_tables.push_back(std::move(lstate.hash_table));
+		for (idx_t key_idx = 0; key_idx < lstate.key_ranges.size(); key_idx++) {
+			gstate.key_ranges[key_idx].Merge(lstate.key_ranges[key_idx]);
+		}
 	}
 	auto &client_profiler = QueryProfiler::Get(context.client);
 	context.thread.profiler.Flush(*this, lstate.build_executor, "build_executor", 1);
@@ -303,6 +394,26 @@ public:
 			// Single-threaded finalize
 			finalize_tasks.push_back(
 			    make_uniq<HashJoinFinalizeTask>(shared_from_this(), context, sink, 0, chunk_count, false));
+		} else if (ht.CanFinalizePartitioned()) {
+			// Parallel finalize of whole partitions: the entries of every partition are a contiguous range of the
+			// pointer table, so the tasks insert without atomics. Every task takes partitions until it has its share
+			const auto &partition_offsets = ht.GetPartitionChunkOffsets();
+			const auto partition_count = partition_offsets.size() - 1;
+			auto chunks_per_thread = MaxValue<idx_t>((chunk_count + num_threads - 1) / num_threads, 1);
+
+			idx_t partition_idx = 0;
+			while (partition_idx < partition_count) {
+				auto chunk_idx_from = partition_offsets[partition_idx];
+				do {
+					partition_idx++;
+				} while (partition_idx < partition_count &&
+				         partition_offsets[partition_idx] - chunk_idx_from < chunks_per_thread);
+				auto chunk_idx_to = partition_offsets[partition_idx];
+				if (chunk_idx_from != chunk_idx_to) {
+					finalize_tasks.push_back(make_uniq<HashJoinFinalizeTask>(shared_from_this(), context, sink,
+					                                                         chunk_idx_from, chunk_idx_to, false));
+				}
+			}
 		} else {
 			// Parallel finalize
 			auto chunks_per_thread = MaxValue<idx_t>((chunk_count + num_threads - 1) / num_threads, 1);
@@ -325,6 +436,7 @@ public:
 	void FinishEvent() override {
 		sink.hash_table->GetDataCollection().VerifyEverythingPinned();
 		sink.hash_table->finalized = true;
+		sink.CacheHashTable();
 	}
 
 	static constexpr const idx_t PARALLEL_CONSTRUCT_THRESHOLD = 1048576;
@@ -333,6 +445,7 @@ public:
 void HashJoinGlobalSinkState::ScheduleFinalize(Pipeline &pipeline, Event &event) {
 	if (hash_table->Count() == 0) {
 		hash_table->finalized = true;
+		CacheHashTable();
 		return;
 	}
 	hash_table->InitializePointerTable();
@@ -340,6 +453,26 @@ void HashJoinGlobalSinkState::ScheduleFinalize(Pipeline &pipeline, Event &event)
 	event.InsertEvent(std::move(new_event));
 }
 
+void HashJoinGlobalSinkState::CacheHashTable() {
+	if (!cache_hash_table || external || perfect_join_executor) {
+		return;
+	}
+	auto entry = make_shared<CachedJoinHashTable>();
+	// the runtime filter belongs to this query, and is only filled during finalize
+	hash_table->runtime_filter = nullptr;
+	entry->hash_table = hash_table;
+	for (auto &key_range : key_ranges) {
+		entry->key_ranges.push_back(key_range.Copy());
+	}
+	for (auto &table : op.cache_tables) {
+		entry->tables.push_back(table);
+	}
+	entry->versions = cache_versions;
+	entry->size = hash_table->SizeInBytes() + JoinHashTable::PointerTableSize(hash_table->Count());
+	auto max_memory = JoinHashTableCache::MAX_MEMORY_RATIO * BufferManager::GetBufferManager(context).GetMaxMemory();
+	JoinHashTableCache::Get(context).Insert(op.cache_key, std::move(entry), idx_t(max_memory));
+}
+
 void HashJoinGlobalSinkState::InitializeProbeSpill() {
 	lock_guard<mutex> guard(lock);
 	if (!probe_spill) {
@@ -399,6 +532,29 @@ public:
 SinkFinalizeType PhysicalHashJoin::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                             OperatorSinkFinalizeInput &input) const {
 	auto &sink = input.global_state.Cast<HashJoinGlobalSinkState>();
+	if (sink.cached_hash_table) {
+		// use the cached hash table, which is finalized already
+		auto &cached = *sink.cached_hash_table;
+		sink.local_hash_tables.clear();
+		sink.perfect_join_executor.reset();
+		sink.external = false;
+		sink.hash_table = cached.hash_table;
+		if (runtime_filter) {
+			// the Bloom filter is not cached, only the ranges of the keys (if the query that built the hash table
+			// tracked them)
+			for (idx_t key_idx = 0; key_idx < cached.key_ranges.size(); key_idx++) {
+				if (JoinRuntimeFilter::SupportsRange(runtime_filter->key_types[key_idx])) {
+					runtime_filter->SetRange(key_idx, cached.key_ranges[key_idx]);
+				}
+			}
+			runtime_filter->Enable();
+		}
+		sink.finalized = true;
+		if (sink.hash_table->Count() == 0 && EmptyResultIfRHSIsEmpty()) {
+			return SinkFinalizeType::NO_OUTPUT_POSSIBLE;
+		}
+		return SinkFinalizeType::READY;
+	}
 	auto &ht = *sink.hash_table;
 
 	sink.external = ht.RequiresExternalJoin(context.config, sink.local_hash_tables);
@@ -426,14 +582,26 @@ SinkFinalizeType PhysicalHashJoin::Finalize(Pipeline &pipeline, Event &event, Cl
 	}
 
 	// check for possible perfect hash table
-	// auto use_perfect_hash = sink.perfect_join_executor->CanDoPerfectHashJoin();
-	// yiqiao: disable the perfect hash
-	auto use_perfect_hash = false;
+	auto use_perfect_hash = sink.perfect_join_executor->CanDoPerfectHashJoin();
 	if (use_perfect_hash) {
 		D_ASSERT(ht.equality_types.size() == 1);
 		auto key_type = ht.equality_types[0];
 		use_perfect_hash = sink.perfect_join_executor->BuildPerfectHashTable(key_type);
 	}
+	if (runtime_filter) {
+		// the runtime filter is not used for external joins, as their hash table only holds some of the partitions
+		for (idx_t key_idx = 0; key_idx < sink.key_ranges.size(); key_idx++) {
+			if (JoinRuntimeFilter::SupportsRange(runtime_filter->key_types[key_idx])) {
+				runtime_filter->SetRange(key_idx, sink.key_ranges[key_idx]);
+			}
+		}
+		if (!use_perfect_hash && ht.Count() > 0) {
+			// the Bloom filter is filled with the hashes of the build keys when the hash table is finalized
+			runtime_filter->InitializeBloomFilter(ht.Count());
+			ht.runtime_filter = runtime_filter.get();
+		}
+		runtime_filter->Enable();
+	}
 	// In case of a large build side or duplicates, use regular hash join
 	if (!use_perfect_hash) {
 		sink.perfect_join_executor.reset();
@@ -460,16 +628,23 @@ public:
 
 	ExpressionExecutor probe_executor;
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+	//! Holds the results of a probe that did not fit in the output chunk
+	DataChunk probe_buffer;
 	unique_ptr<OperatorState> perfect_hash_join_state;
 
 	bool initialized;
 	JoinHashTable::ProbeSpillLocalAppendState spill_state;
 	//! Chunk to sink data into for external join
 	DataChunk spill_chunk;
+	//! The filter over the output of the join (if any)
+	unique_ptr<JoinFilterState> filter_state;
 
 public:
 	void Finalize(const PhysicalOperator &op, ExecutionContext &context) override {
 		context.thread.profiler.Flush(op, probe_executor, "probe_executor", 0);
+		if (filter_state) {
+			context.thread.profiler.Flush(op, filter_state->executor, "filter", 1);
+		}
 	}
 };
 
@@ -490,6 +665,9 @@ unique_ptr<OperatorState> PhysicalHashJoin::GetOperatorState(ExecutionContext &c
 		state->spill_chunk.Initialize(allocator, sink.probe_types);
 		sink.InitializeProbeSpill();
 	}
+	if (filter) {
+		state->filter_state = make_uniq<JoinFilterState>(context.client, *filter, types, filter_build_columns);
+	}
 
 	return std::move(state);
 }
@@ -516,12 +694,30 @@ OperatorResultType PhysicalHashJoin::ExecuteInternal(ExecutionContext &context,
 
 	if (sink.perfect_join_executor) {
 		D_ASSERT(!sink.external);
-		return sink.perfect_join_executor->ProbePerfectHashTable(context, input, chunk, *state.perfect_hash_join_state);
+		// the probe emits a slice of the input, which the compaction stage gathers like the output of a regular probe
+		auto result =
+		    sink.perfect_join_executor->ProbePerfectHashTable(context, input, chunk, *state.perfect_hash_join_state);
+		if (state.filter_state) {
+			// the perfect hash join gathers its build columns in bulk, so the filter is resolved afterwards
+			auto &filter_state = *state.filter_state;
+			auto filter_count = filter_state.executor.SelectExpression(chunk, filter_state.sel);
+			if (filter_count < chunk.size()) {
+				chunk.Slice(filter_state.sel, filter_count);
+			}
+		}
+		if (HashJoinProfiler::kEnableProfiling) {
+			HashJoinProfiler::Get().InputChunk(input.size(), to_string(size_t(this)), JoinTypeToString(join_type));
+			HashJoinProfiler::Get().OutputChunk(input.size(), chunk.size(), to_string(size_t(this)));
+		}
+		return result;
 	}
 
 	if (state.scan_structure) {
 		// still have elements remaining (i.e. we got >STANDARD_VECTOR_SIZE elements in the previous probe)
 		state.scan_structure->Next(state.join_keys, input, chunk);
+		if (HashJoinProfiler::kEnableProfiling) {
+			HashJoinProfiler::Get().OutputChunk(input.size(), chunk.size(), to_string(size_t(this)));
+		}
 
 		if (chunk.size() > 0) {
 			return OperatorResultType::HAVE_MORE_OUTPUT;
@@ -542,12 +738,24 @@ OperatorResultType PhysicalHashJoin::ExecuteInternal(ExecutionContext &context,
 
 	// perform the actual probe
 	if (sink.external) {
-		state.scan_structure = sink.hash_table->ProbeAndSpill(state.join_keys, state.join_key_state, input,
-		                                                      *sink.probe_spill, state.spill_state, state.spill_chunk);
+		state.scan_structure =
+		    sink.hash_table->ProbeAndSpill(state.join_keys, state.join_key_state, state.probe_buffer, input,
+		                                   *sink.probe_spill, state.spill_state, state.spill_chunk);
 	} else {
-		state.scan_structure = sink.hash_table->Probe(state.join_keys, state.join_key_state);
+		state.scan_structure = sink.hash_table->Probe(state.join_keys, state.join_key_state, state.probe_buffer);
 	}
+	state.scan_structure->filter_state = state.filter_state.get();
 	state.scan_structure->Next(state.join_keys, input, chunk);
+	if (HashJoinProfiler::kEnableProfiling) {
+		HashJoinProfiler::Get().InputChunk(input.size(), to_string(size_t(this)), JoinTypeToString(join_type));
+		HashJoinProfiler::Get().OutputChunk(input.size(), chunk.size(), to_string(size_t(this)));
+	}
+	if (state.scan_structure->Finished()) {
+		// semi, anti, mark and single joins emit a single chunk per probe: asking for more input right away lets the
+		// compaction gather their sparse results across probes without an empty round trip through the pipeline
+		state.scan_structure = nullptr;
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
 	return OperatorResultType::HAVE_MORE_OUTPUT;
 }
 
@@ -572,6 +780,8 @@ public:
 	void PrepareScanHT(HashJoinGlobalSinkState &sink);
 	//! Assigns a task to a local source state
 	bool AssignTask(HashJoinGlobalSinkState &sink, HashJoinLocalSourceState &lstate);
+	//! Takes the next chunks of the full/outer scan from the shared cursor (does not need the lock)
+	bool AssignFullOuterChunks(HashJoinLocalSourceState &lstate);
 
 	idx_t MaxThreads() override {
 		D_ASSERT(op.sink_state);
@@ -609,11 +819,11 @@ public:
 	idx_t probe_count;
 	idx_t parallel_scan_chunk_count;
 
-	//! For full/outer synchronization
-	idx_t full_outer_chunk_idx;
+	//! For full/outer synchronization, threads take the chunks to scan from the shared cursor until all are taken
+	atomic<idx_t> full_outer_chunk_idx;
 	idx_t full_outer_chunk_count;
 	idx_t full_outer_chunk_done;
-	idx_t full_outer_chunks_per_thread;
+	idx_t full_outer_chunks_per_task;
 };
 
 class HashJoinLocalSourceState : public LocalSourceState {
@@ -651,23 +861,34 @@ public:
 	vector<idx_t> payload_indices;
 	//! Scan structure for the external probe
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+	//! Holds the results of the external probe that did not fit in the output chunk
+	DataChunk probe_buffer;
 	bool empty_ht_probe_in_progress;
 
+	//! The filter over the output of the join (if any)
+	unique_ptr<JoinFilterState> filter_state;
+
 	//! Chunks assigned to this thread for a full/outer scan
 	idx_t full_outer_chunk_idx_from;
 	idx_t full_outer_chunk_idx_to;
 	unique_ptr<JoinHTScanState> full_outer_scan_state;
+	//! The chunks this thread scanned completely, but whose rows were not emitted yet
+	idx_t full_outer_chunks_scanned;
 };
 
 unique_ptr<GlobalSourceState> PhysicalHashJoin::GetGlobalSourceState(ClientContext &context) const {
-	// yiqiao: there is no external join in my setting, so probing stage ends.
+	// yiqiao: the probe of the streamed tuples ends here, the source only probes the spilled ones (if any).
 	CatProfiler::Get().EndStage("[HashJoin - Probe Hash Table]");
 	return make_uniq<HashJoinGlobalSourceState>(*this, context);
 }
 
 unique_ptr<LocalSourceState> PhysicalHashJoin::GetLocalSourceState(ExecutionContext &context,
                                                                    GlobalSourceState &gstate) const {
-	return make_uniq<HashJoinLocalSourceState>(*this, BufferAllocator::Get(context.client));
+	auto result = make_uniq<HashJoinLocalSourceState>(*this, BufferAllocator::Get(context.client));
+	if (filter) {
+		result->filter_state = make_uniq<JoinFilterState>(context.client, *filter, types, filter_build_columns);
+	}
+	return std::move(result);
 }
 
 HashJoinGlobalSourceState::HashJoinGlobalSourceState(const PhysicalHashJoin &op, ClientContext &context)
@@ -776,8 +997,11 @@ void HashJoinGlobalSourceState::PrepareScanHT(HashJoinGlobalSinkState &sink) {
 	full_outer_chunk_count = data_collection.ChunkCount();
 	full_outer_chunk_done = 0;
 
+	// small tasks, so that the threads that find few rows without a match take more chunks
+	static constexpr idx_t FULL_OUTER_TASKS_PER_THREAD = 8;
 	auto num_threads = TaskScheduler::GetScheduler(sink.context).NumberOfThreads();
-	full_outer_chunks_per_thread = MaxValue<idx_t>((full_outer_chunk_count + num_threads - 1) / num_threads, 1);
+	full_outer_chunks_per_task =
+	    MaxValue<idx_t>(full_outer_chunk_count / (num_threads * FULL_OUTER_TASKS_PER_THREAD), 1);
 
 	global_stage = HashJoinSourceStage::SCAN_HT;
 }
@@ -804,12 +1028,8 @@ bool HashJoinGlobalSourceState::AssignTask(HashJoinGlobalSinkState &sink, HashJo
 			}
 			break;
 		case HashJoinSourceStage::SCAN_HT:
-			if (full_outer_chunk_idx != full_outer_chunk_count) {
+			if (AssignFullOuterChunks(lstate)) {
 				lstate.local_stage = global_stage;
-				lstate.full_outer_chunk_idx_from = full_outer_chunk_idx;
-				full_outer_chunk_idx =
-				    MinValue<idx_t>(full_outer_chunk_count, full_outer_chunk_idx + full_outer_chunks_per_thread);
-				lstate.full_outer_chunk_idx_to = full_outer_chunk_idx;
 				return true;
 			}
 			break;
@@ -821,8 +1041,22 @@ bool HashJoinGlobalSourceState::AssignTask(HashJoinGlobalSinkState &sink, HashJo
 	return false;
 }
 
+bool HashJoinGlobalSourceState::AssignFullOuterChunks(HashJoinLocalSourceState &lstate) {
+	if (full_outer_chunk_idx >= full_outer_chunk_count) {
+		return false;
+	}
+	auto chunk_idx_from = full_outer_chunk_idx.fetch_add(full_outer_chunks_per_task);
+	if (chunk_idx_from >= full_outer_chunk_count) {
+		return false;
+	}
+	lstate.full_outer_chunk_idx_from = chunk_idx_from;
+	lstate.full_outer_chunk_idx_to =
+	    MinValue<idx_t>(full_outer_chunk_count, chunk_idx_from + full_outer_chunks_per_task);
+	return true;
+}
+
 HashJoinLocalSourceState::HashJoinLocalSourceState(const PhysicalHashJoin &op, Allocator &allocator)
-    : local_stage(HashJoinSourceStage::INIT), addresses(LogicalType::POINTER) {
+    : local_stage(HashJoinSourceStage::INIT), addresses(LogicalType::POINTER), full_outer_chunks_scanned(0) {
 	auto &chunk_state = probe_local_scan.current_chunk_state;
 	chunk_state.properties = ColumnDataScanProperties::ALLOW_ZERO_COPY;
 
@@ -920,7 +1154,8 @@ void HashJoinLocalSourceState::ExternalProbe(HashJoinGlobalSinkState &sink, Hash
 	}
 
 	// Perform the probe
-	scan_structure = sink.hash_table->Probe(join_keys, join_key_state, precomputed_hashes);
+	scan_structure = sink.hash_table->Probe(join_keys, join_key_state, probe_buffer, precomputed_hashes);
+	scan_structure->filter_state = filter_state.get();
 	scan_structure->Next(join_keys, payload, chunk);
 }
 
@@ -928,16 +1163,32 @@ void HashJoinLocalSourceState::ExternalScanHT(HashJoinGlobalSinkState &sink, Has
                                               DataChunk &chunk) {
 	D_ASSERT(local_stage == HashJoinSourceStage::SCAN_HT);
 
-	if (!full_outer_scan_state) {
-		full_outer_scan_state = make_uniq<JoinHTScanState>(sink.hash_table->GetDataCollection(),
-		                                                   full_outer_chunk_idx_from, full_outer_chunk_idx_to);
+	// fill the output with the rows without a match of as many chunks as it takes, taking more chunks from the shared
+	// cursor when the assigned ones are done, so that mostly matched build sides do not produce tiny chunks
+	auto &ht = *sink.hash_table;
+	idx_t found_entries = 0;
+	while (true) {
+		if (!full_outer_scan_state) {
+			full_outer_scan_state =
+			    make_uniq<JoinHTScanState>(ht.GetDataCollection(), full_outer_chunk_idx_from, full_outer_chunk_idx_to);
+		}
+		found_entries = ht.ScanFullOuterAddresses(*full_outer_scan_state, addresses, found_entries);
+		if (found_entries == STANDARD_VECTOR_SIZE) {
+			break;
+		}
+		full_outer_scan_state = nullptr;
+		full_outer_chunks_scanned += full_outer_chunk_idx_to - full_outer_chunk_idx_from;
+		if (!gstate.AssignFullOuterChunks(*this)) {
+			break;
+		}
 	}
-	sink.hash_table->ScanFullOuter(*full_outer_scan_state, addresses, chunk);
+	ht.GatherFullOuter(addresses, found_entries, chunk);
 
-	if (chunk.size() == 0) {
-		full_outer_scan_state = nullptr;
+	if (!full_outer_scan_state) {
+		// the rows of the scanned chunks are emitted, the next stage can only start once they are counted as done
 		lock_guard<mutex> guard(gstate.lock);
-		gstate.full_outer_chunk_done += full_outer_chunk_idx_to - full_outer_chunk_idx_from;
+		gstate.full_outer_chunk_done += full_outer_chunks_scanned;
+		full_outer_chunks_scanned = 0;
 	}
 }
 
@@ -26,6 +26,30 @@ bool PhysicalJoin::EmptyResultIfRHSIsEmpty() const {
 //===--------------------------------------------------------------------===//
 // Pipeline Construction
 //===--------------------------------------------------------------------===//
+//! Lets the pipelines of the build side of the hash join wait for the builds of the hash joins above it, whose runtime
+//! filters are applied on the build side. These joins are in the same pipeline, so they have already been built into
+//! MetaPipelines below the current one.
+static void AddBuildDependencies(MetaPipeline &meta_pipeline, MetaPipeline &child_meta_pipeline,
+                                 const PhysicalHashJoin &join) {
+	if (join.build_dependencies.empty()) {
+		return;
+	}
+	vector<shared_ptr<MetaPipeline>> meta_pipelines;
+	meta_pipeline.GetMetaPipelines(meta_pipelines, true, true);
+	vector<shared_ptr<Pipeline>> build_pipelines;
+	child_meta_pipeline.GetPipelines(build_pipelines, false);
+	for (auto &dependency : join.build_dependencies) {
+		for (auto &dependency_meta_pipeline : meta_pipelines) {
+			if (dependency_meta_pipeline->GetSink().get() != &dependency.get()) {
+				continue;
+			}
+			for (auto &build_pipeline : build_pipelines) {
+				build_pipeline->AddDependency(dependency_meta_pipeline->GetBasePipeline());
+			}
+		}
+	}
+}
+
 void PhysicalJoin::BuildJoinPipelines(Pipeline &current, MetaPipeline &meta_pipeline, PhysicalOperator &op) {
 	op.op_state.reset();
 	op.sink_state.reset();
@@ -42,6 +66,9 @@ void PhysicalJoin::BuildJoinPipelines(Pipeline &current, MetaPipeline &meta_pipe
 	// on the RHS (build side), we construct a child MetaPipeline with this operator as its sink
 	auto &child_meta_pipeline = meta_pipeline.CreateChildMetaPipeline(current, op);
 	child_meta_pipeline.Build(*op.children[1]);
+	if (op.type == PhysicalOperatorType::HASH_JOIN) {
+		AddBuildDependencies(meta_pipeline, child_meta_pipeline, op.Cast<PhysicalHashJoin>());
+	}
 
 	// continue building the current pipeline on the LHS (probe side)
 	op.children[0]->BuildPipelines(current, meta_pipeline);
@@ -58,6 +58,9 @@ public:
 	}
 
 	unique_ptr<LocalTableFunctionState> local_state;
+	//! The hashes and selection of the runtime filters
+	Vector runtime_filter_hashes {LogicalType::HASH};
+	SelectionVector runtime_filter_sel {STANDARD_VECTOR_SIZE};
 };
 
 unique_ptr<LocalSourceState> PhysicalTableScan::GetLocalSourceState(ExecutionContext &context,
@@ -76,11 +79,37 @@ SourceResultType PhysicalTableScan::GetData(ExecutionContext &context, DataChunk
 	auto &state = input.local_state.Cast<TableScanLocalSourceState>();
 
 	TableFunctionInput data(bind_data.get(), state.local_state.get(), gstate.global_state.get());
-	function.function(context.client, data, chunk);
+	while (true) {
+		function.function(context.client, data, chunk);
+		if (chunk.size() == 0 || ApplyRuntimeFilters(chunk, state) > 0) {
+			break;
+		}
+		// all tuples were filtered out: scan the next chunk
+		chunk.Reset();
+	}
 
 	return chunk.size() == 0 ? SourceResultType::FINISHED : SourceResultType::HAVE_MORE_OUTPUT;
 }
 
+idx_t PhysicalTableScan::ApplyRuntimeFilters(DataChunk &chunk, LocalSourceState &lstate) const {
+	auto &state = lstate.Cast<TableScanLocalSourceState>();
+	for (auto &runtime_filter : runtime_filters) {
+		if (!runtime_filter->IsEnabled()) {
+			continue;
+		}
+		auto count = runtime_filter->Select(chunk, state.runtime_filter_hashes, state.runtime_filter_sel);
+		if (count == 0) {
+			return 0;
+		}
+		if (count < chunk.size()) {
+			chunk.Slice(state.runtime_filter_sel, count);
+			// the sliced chunk references the selection, the next filter selects into a new one
+			state.runtime_filter_sel.Initialize(STANDARD_VECTOR_SIZE);
+		}
+	}
+	return chunk.size();
+}
+
 double PhysicalTableScan::GetProgress(ClientContext &context, GlobalSourceState &gstate_p) const {
 	auto &gstate = gstate_p.Cast<TableScanGlobalSourceState>();
 	if (function.table_scan_progress) {
@@ -145,6 +174,18 @@ string PhysicalTableScan::ParamsToString() const {
 			}
 		}
 	}
+	if (!runtime_filters.empty()) {
+		result += "\n[INFOSEPARATOR]\n";
+		result += "Runtime Filters: ";
+		for (auto &runtime_filter : runtime_filters) {
+			for (auto &scan_column : runtime_filter->scan_columns) {
+				auto column_index = projection_ids.empty() ? scan_column : projection_ids[scan_column];
+				const auto &column_id = column_ids[column_index];
+				result += column_id < names.size() ? names[column_id] : "rowid";
+				result += "\n";
+			}
+		}
+	}
 	if (!extra_info.file_filters.empty()) {
 		result += "\n[INFOSEPARATOR]\n";
 		result += "File Filters: " + extra_info.file_filters;
@@ -5,6 +5,7 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/tree_renderer.hpp"
 #include "duckdb/execution/execution_context.hpp"
+#include "duckdb/execution/executor.hpp"
 #include "duckdb/execution/operator/set/physical_recursive_cte.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/parallel/meta_pipeline.hpp"
@@ -216,97 +217,337 @@ void PhysicalOperator::Verify() {
 #endif
 }
 
-bool CompactingPhysicalOperator::CanCacheType(const LogicalType &type) {
-	switch (type.id()) {
-		case LogicalTypeId::LIST:
-		case LogicalTypeId::MAP:
-			return false;
-		case LogicalTypeId::STRUCT: {
-			auto &entries = StructType::GetChildTypes(type);
-			for (auto &entry : entries) {
-				if (!CanCacheType(entry.second)) {
-					return false;
-				}
+CompactingPhysicalOperator::CompactingPhysicalOperator(PhysicalOperatorType type, vector<LogicalType> types_p,
+                                                       idx_t estimated_cardinality)
+    : PhysicalOperator(type, std::move(types_p), estimated_cardinality), compacting_supported(true) {
+}
+
+string CompactingPhysicalOperator::CompactionToString() const {
+	if (compaction_info.empty()) {
+		return "";
+	}
+	return string(compacting_supported ? "Compaction: " : "No Compaction: ") + compaction_info;
+}
+
+//! Reserves the child capacity that the nested vectors of the previous compaction buffer ended up with, so that
+//! appending LIST/MAP columns to the new buffer copies the child vectors in amortized constant time per element
+static void ReserveNestedCapacity(Vector &target, Vector &previous) {
+	switch (target.GetType().InternalType()) {
+		case PhysicalType::LIST:
+			ListVector::Reserve(target, ListVector::GetListSize(previous));
+			ReserveNestedCapacity(ListVector::GetEntry(target), ListVector::GetEntry(previous));
+			break;
+		case PhysicalType::STRUCT: {
+			auto &target_entries = StructVector::GetEntries(target);
+			auto &previous_entries = StructVector::GetEntries(previous);
+			for (idx_t i = 0; i < target_entries.size(); i++) {
+				ReserveNestedCapacity(*target_entries[i], *previous_entries[i]);
 			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+//! Returns the flat data the vector reads its rows from, or nullptr if it does not read from a single flat vector
+static data_ptr_t SliceSource(Vector &vector) {
+	switch (vector.GetVectorType()) {
+		case VectorType::FLAT_VECTOR:
+			return vector.GetData();
+		case VectorType::DICTIONARY_VECTOR: {
+			auto &child = DictionaryVector::Child(vector);
+			return child.GetVectorType() == VectorType::FLAT_VECTOR ? child.GetData() : nullptr;
+		}
+		default:
+			return nullptr;
+	}
+}
+
+//! Whether the output vector is a slice of one of the columns of the input chunk
+static bool IsSliceOfInput(Vector &vector, DataChunk &input) {
+	if (vector.GetVectorType() != VectorType::DICTIONARY_VECTOR) {
+		return false;
+	}
+	auto source = SliceSource(vector);
+	if (!source) {
+		return false;
+	}
+	for (auto &input_vector : input.data) {
+		if (SliceSource(input_vector) == source) {
 			return true;
 		}
+	}
+	return false;
+}
+
+//! Whether copying a value of the type copies the entries of a list
+static bool ContainsList(const LogicalType &type) {
+	switch (type.InternalType()) {
+		case PhysicalType::LIST:
+			return true;
+		case PhysicalType::STRUCT:
+			for (auto &child_type : StructType::GetChildTypes(type)) {
+				if (ContainsList(child_type.second)) {
+					return true;
+				}
+			}
+			return false;
 		default:
+			return false;
+	}
+}
+
+//! Whether the chunk repeats the lists of a single row in all of its rows, as unnests and in-out functions do with the
+//! input row they are processing. Copying such a chunk into the buffer would copy the list entries once per row.
+static bool RepeatsLists(DataChunk &chunk) {
+	for (auto &vector : chunk.data) {
+		if (vector.GetVectorType() == VectorType::CONSTANT_VECTOR && ContainsList(vector.GetType())) {
 			return true;
+		}
 	}
+	return false;
 }
 
-CompactingPhysicalOperator::CompactingPhysicalOperator(PhysicalOperatorType type, vector<LogicalType> types_p,
-                                                       idx_t estimated_cardinality)
-    : PhysicalOperator(type, std::move(types_p), estimated_cardinality) {
-	compacting_supported = true;
-	for (auto &col_type : types) {
-		if (!CanCacheType(col_type)) {
-			compacting_supported = false;
-			break;
+//! Replaces a sliced column of the compaction buffer by a flat copy that has room for a full chunk
+static void MaterializeSlice(Vector &vector, idx_t count) {
+	Vector flat(vector.GetType());
+	VectorOperations::Copy(vector, flat, count, 0, 0);
+	vector.Reference(flat);
+}
+
+//! Appends the rows [source_offset, source_offset + count) of the chunk to the compaction buffer. Columns that slice
+//! the current input chunk are appended by extending the selection vector of the buffer (logical compaction), all
+//! other columns are copied. Returns the number of tuples that were copied.
+//! A dictionary vector selects from a single child, and the pipeline reuses the buffers of the input chunk once the
+//! operator needs more input. Logical compaction therefore only merges the chunks emitted for one input, and does
+//! not apply to operators that emit at most one chunk per input, such as filters.
+static idx_t AppendToCache(CachingOperatorState &state, DataChunk &input, DataChunk &chunk, idx_t source_offset,
+                           idx_t count, bool more_output) {
+	auto &cache = *state.cached_chunk;
+	auto offset = cache.size();
+	bool copied = false;
+	if (offset == 0) {
+		// only slices of an input that produces more output are worth keeping: the others are copied right away
+		for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+			state.sliced_columns[col_idx] =
+			    state.logical_compaction && more_output && IsSliceOfInput(chunk.data[col_idx], input);
 		}
 	}
+	for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+		auto &source = chunk.data[col_idx];
+		auto &target = cache.data[col_idx];
+		if (state.sliced_columns[col_idx] && offset > 0 &&
+		    (source.GetVectorType() != VectorType::DICTIONARY_VECTOR || SliceSource(source) != SliceSource(target))) {
+			// the column no longer slices the same data: materialize what we have and copy from now on
+			MaterializeSlice(target, offset);
+			state.sliced_columns[col_idx] = false;
+		}
+		if (!state.sliced_columns[col_idx]) {
+			VectorOperations::Copy(source, target, source_offset + count, source_offset, offset);
+			copied = true;
+			continue;
+		}
+		// the selection vector of the operator output can be reused by the operator, so we copy it into our own
+		auto &source_sel = DictionaryVector::SelVector(source);
+		if (offset == 0) {
+			SelectionVector sel(STANDARD_VECTOR_SIZE);
+			for (idx_t i = 0; i < count; i++) {
+				sel.set_index(i, source_sel.get_index(source_offset + i));
+			}
+			target.Slice(DictionaryVector::Child(source), sel, count);
+		} else {
+			auto &target_sel = DictionaryVector::SelVector(target);
+			for (idx_t i = 0; i < count; i++) {
+				target_sel.set_index(offset + i, source_sel.get_index(source_offset + i));
+			}
+		}
+	}
+	cache.SetCardinality(offset + count);
+	return copied ? count : 0;
 }
 
-OperatorResultType CompactingPhysicalOperator::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
-                                                       GlobalOperatorState &gstate, OperatorState &state_p) const {
-	auto &state = state_p.Cast<CachingOperatorState>();
+//! Copies the rows of the sliced columns of the compaction buffer, before the input chunk they slice is replaced.
+//! Returns the number of tuples that were copied.
+static idx_t MaterializeCache(CachingOperatorState &state) {
+	auto &cache = *state.cached_chunk;
+	bool copied = false;
+	for (idx_t col_idx = 0; col_idx < cache.ColumnCount(); col_idx++) {
+		if (state.sliced_columns[col_idx]) {
+			MaterializeSlice(cache.data[col_idx], cache.size());
+			state.sliced_columns[col_idx] = false;
+			copied = true;
+		}
+	}
+	return copied ? cache.size() : 0;
+}
 
-	// Execute child operator
-	auto child_result = ExecuteInternal(context, input, chunk, gstate, state);
+CachingOperatorState::CachingOperatorState() {
+}
 
+CachingOperatorState::~CachingOperatorState() {
+}
+
+//===--------------------------------------------------------------------===//
+// Compaction Stage
+//===--------------------------------------------------------------------===//
+void CompactionStage::TuneCompactThreshold(CachingOperatorState &state) {
+	// the reward is the number of tuples that were pushed downstream per nanosecond
+	state.tuning_timer.End();
+	auto elapsed_ns = state.tuning_timer.Elapsed() * 1e9;
+	if (elapsed_ns > 0) {
+		state.tuner->UpdateArm(state.compact_threshold, double(state.emitted_tuples) / elapsed_ns);
+	}
+
+	state.compact_threshold = state.tuner->SelectArm();
+	state.emitted_tuples = 0;
+	state.tuning_timer.Start();
+}
+
+//! Whether the chunks the operator emits reach a sink that accepts sparse chunks without passing through another
+//! operator that changes their density, in which case compacting them only adds a copy
+static bool FeedsFragmentSink(ExecutionContext &context, const PhysicalOperator &op) {
+	auto sink = context.pipeline->GetSink();
+	if (!sink || !sink->SinkAcceptsFragments()) {
+		return false;
+	}
+	// the operators of the pipeline start with its source and end with its sink
+	auto operators = context.pipeline->GetOperators();
+	bool after_op = false;
+	for (idx_t op_idx = 1; op_idx + 1 < operators.size(); op_idx++) {
+		auto &current = operators[op_idx].get();
+		if (after_op && current.type != PhysicalOperatorType::PROJECTION) {
+			return false;
+		}
+		after_op = after_op || &current == &op;
+	}
+	return after_op;
+}
+
+void CompactionStage::Prepare(ExecutionContext &context, const PhysicalOperator &op, idx_t compact_threshold,
+                              CachingOperatorState &state) {
 #if STANDARD_VECTOR_SIZE >= 128
 	if (!state.initialized) {
 		state.initialized = true;
-		state.can_cache_chunk = compacting_supported && PhysicalOperator::OperatorCachingAllowed(context);
+		state.can_cache_chunk = PhysicalOperator::OperatorCachingAllowed(context) && !FeedsFragmentSink(context, op);
+		state.compact_threshold = compact_threshold;
+		state.logical_compaction = ClientConfig::GetConfig(context.client).enable_logical_compaction;
+		if (state.can_cache_chunk && ClientConfig::GetConfig(context.client).enable_compaction_tuning) {
+			state.tuner = context.pipeline->executor.GetCompactTuner().CreateBandit(size_t(&op));
+			state.compact_threshold = state.tuner->SelectArm();
+			state.tuning_timer.Start();
+		}
+	} else if (state.tuner && state.emitted_tuples > 0) {
+		// the chunk emitted with the current threshold has been processed downstream
+		TuneCompactThreshold(state);
 	}
+#endif
+}
+
+void CompactionStage::Compact(ExecutionContext &context, const PhysicalOperator &op, DataChunk &input,
+                              DataChunk &chunk, OperatorResultType result, CachingOperatorState &state) {
+#if STANDARD_VECTOR_SIZE >= 128
 	if (!state.can_cache_chunk) {
-		return child_result;
+		return;
 	}
+	idx_t tuples_copied = 0;
+	bool flushed = false;
 	// TODO chunk size of 0 should not result in a cache being created!
-	if (chunk.size() < compact_threshold) {
+	if (chunk.size() < state.compact_threshold && !RepeatsLists(chunk)) {
 		// we have filtered out a significant amount of tuples
 		// add this chunk to the cache and continue
 		if (!state.cached_chunk) {
 			state.cached_chunk = make_uniq<DataChunk>();
 			state.cached_chunk->Initialize(Allocator::Get(context.client), chunk.GetTypes());
+			state.sliced_columns.resize(chunk.ColumnCount(), false);
 		}
 
-		// yiqiao: this is a hack to avoid the case where the chunk is too big to fit in the cache caused by tuning
-		// compaction threshold.
-		if (chunk.size() > STANDARD_VECTOR_SIZE - state.cached_chunk->size()) {
-			return child_result;
-		}
-
-		state.cached_chunk->Append(chunk);
-		if (state.cached_chunk->size() >= (STANDARD_VECTOR_SIZE - compact_threshold) ||
-		    child_result == OperatorResultType::FINISHED) {
-			// chunk cache full: return it
-			//			chunk.Reset();
-			//			state.cached_chunk->Copy(chunk);
-			//			state.cached_chunk->Reset();
-			chunk.Move(*state.cached_chunk);
-			state.cached_chunk->Initialize(Allocator::Get(context.client), chunk.GetTypes());
-			return child_result;
-		} else {
-			// chunk cache not full return empty result
+		auto more_output = result == OperatorResultType::HAVE_MORE_OUTPUT;
+		auto space = STANDARD_VECTOR_SIZE - state.cached_chunk->size();
+		if (chunk.size() < space && result != OperatorResultType::FINISHED) {
+			// chunk cache not full: return empty result
+			tuples_copied += AppendToCache(state, input, chunk, 0, chunk.size(), more_output);
 			chunk.Reset();
+		} else {
+			// fill up the chunk cache and return it, the rows that do not fit are carried over into the next cache
+			auto appended = MinValue<idx_t>(chunk.size(), space);
+			tuples_copied += AppendToCache(state, input, chunk, 0, appended, more_output);
+			auto full_cache = std::move(state.cached_chunk);
+			state.cached_chunk = make_uniq<DataChunk>();
+			state.cached_chunk->Initialize(Allocator::Get(context.client), chunk.GetTypes());
+			for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+				if (full_cache->data[col_idx].GetVectorType() == VectorType::FLAT_VECTOR) {
+					ReserveNestedCapacity(state.cached_chunk->data[col_idx], full_cache->data[col_idx]);
+				}
+			}
+			std::fill(state.sliced_columns.begin(), state.sliced_columns.end(), false);
+			if (appended < chunk.size()) {
+				tuples_copied += AppendToCache(state, input, chunk, appended, chunk.size() - appended, more_output);
+			}
+			chunk.Move(*full_cache);
+			flushed = true;
 		}
 	}
+	if (state.cached_chunk && result != OperatorResultType::HAVE_MORE_OUTPUT) {
+		// the input chunk is replaced after this call
+		tuples_copied += MaterializeCache(state);
+	}
+	if (tuples_copied > 0 || flushed) {
+		context.thread.profiler.AddCompaction(op, tuples_copied, flushed);
+	}
+	state.emitted_tuples += chunk.size();
+	if (HashJoinProfiler::kEnableProfiling && op.type == PhysicalOperatorType::HASH_JOIN) {
+		HashJoinProfiler::Get().CompactedChunk(chunk.size(), to_string(size_t(&op)));
+	}
 #endif
-
-	return child_result;
 }
 
-OperatorFinalizeResultType CompactingPhysicalOperator::FinalExecute(ExecutionContext &context, DataChunk &chunk,
-                                                                    GlobalOperatorState &gstate,
-                                                                    OperatorState &state_p) const {
-	auto &state = state_p.Cast<CachingOperatorState>();
+void CompactionStage::Flush(DataChunk &chunk, CachingOperatorState &state) {
 	if (state.cached_chunk) {
 		chunk.Move(*state.cached_chunk);
 		state.cached_chunk.reset();
 	} else {
 		chunk.SetCardinality(0);
 	}
+}
+
+bool CompactionStage::NeedsCompaction(const PhysicalOperator &op) {
+	if (op.RequiresFinalExecute()) {
+		// compacting operators compact their own output, and the stage can only be flushed after the operator is
+		return false;
+	}
+	switch (op.type) {
+		case PhysicalOperatorType::PROJECTION:
+		case PhysicalOperatorType::UNNEST:
+		case PhysicalOperatorType::INOUT_FUNCTION:
+			return true;
+		default:
+			return false;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Compacting Physical Operator
+//===--------------------------------------------------------------------===//
+OperatorResultType CompactingPhysicalOperator::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                                       GlobalOperatorState &gstate, OperatorState &state_p) const {
+	auto &state = state_p.Cast<CachingOperatorState>();
+	if (compacting_supported) {
+		CompactionStage::Prepare(context, *this, compact_threshold, state);
+	}
+
+	// Execute child operator
+	auto child_result = ExecuteInternal(context, input, chunk, gstate, state);
+
+	CompactionStage::Compact(context, *this, input, chunk, child_result, state);
+	return child_result;
+}
+
+OperatorFinalizeResultType CompactingPhysicalOperator::FinalExecute(ExecutionContext &context, DataChunk &chunk,
+                                                                    GlobalOperatorState &gstate,
+                                                                    OperatorState &state_p) const {
+	auto &state = state_p.Cast<CachingOperatorState>();
+	CompactionStage::Flush(chunk, state);
 	return OperatorFinalizeResultType::FINISHED;
 }
 
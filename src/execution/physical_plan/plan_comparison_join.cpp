@@ -1,5 +1,7 @@
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
 #include "duckdb/common/operator/subtract.hpp"
+#include "duckdb/execution/operator/filter/physical_filter.hpp"
+#include "duckdb/execution/operator/helper/physical_pipeline_breaker.hpp"
 #include "duckdb/execution/operator/join/perfect_hash_join_executor.hpp"
 #include "duckdb/execution/operator/join/physical_blockwise_nl_join.hpp"
 #include "duckdb/execution/operator/join/physical_cross_product.hpp"
@@ -8,17 +10,267 @@
 #include "duckdb/execution/operator/join/physical_index_join.hpp"
 #include "duckdb/execution/operator/join/physical_nested_loop_join.hpp"
 #include "duckdb/execution/operator/join/physical_piecewise_merge_join.hpp"
+#include "duckdb/execution/operator/projection/physical_projection.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/function/scalar/compressed_materialization_functions.hpp"
 #include "duckdb/function/table/table_scan.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/transaction/duck_transaction.hpp"
 
 namespace duckdb {
 
+//! Lets a pipeline breaker on the probe side of the hash join group its rows by the join key hash
+static void PlanBreakerReorder(PhysicalHashJoin &join) {
+	if (join.children[0]->type != PhysicalOperatorType::PIPELINE_BREAKER) {
+		return;
+	}
+	auto &breaker = join.children[0]->Cast<PhysicalPipelineBreaker>();
+	for (auto &cond : join.conditions) {
+		if (cond.comparison != ExpressionType::COMPARE_EQUAL &&
+		    cond.comparison != ExpressionType::COMPARE_NOT_DISTINCT_FROM) {
+			// the hash table only hashes the equality conditions, which come first
+			break;
+		}
+		breaker.reorder_keys.push_back(cond.left->Copy());
+	}
+	breaker.reorder_capacity = JoinHashTable::PointerTableCapacity(join.children[1]->estimated_cardinality);
+}
+
+//! Returns whether the operator only scans, filters and projects a base table, i.e., whether its pipeline does not
+//! depend on any other pipeline
+static bool IsTableScanPipeline(PhysicalOperator &op) {
+	switch (op.type) {
+	case PhysicalOperatorType::TABLE_SCAN:
+		return true;
+	case PhysicalOperatorType::FILTER:
+	case PhysicalOperatorType::PROJECTION:
+		return IsTableScanPipeline(*op.children[0]);
+	default:
+		return false;
+	}
+}
+
+//! Buffers the probe side of the hash join in a pipeline breaker. The pipeline that fills the breaker does not depend
+//! on the build side, so the executor runs it concurrently with the build, and the probe scans the buffer afterwards
+static void PlanEarlyProbe(unique_ptr<PhysicalOperator> &left) {
+	if (!IsTableScanPipeline(*left)) {
+		return;
+	}
+	auto types = left->types;
+	auto estimated_cardinality = left->estimated_cardinality;
+	left = make_uniq<PhysicalPipelineBreaker>(std::move(types), std::move(left), estimated_cardinality);
+}
+
+//! Follows the given output columns down the probe pipeline to the table scan that produces them. If build_join is
+//! given, the columns may also be followed into the build side of a hash join below, which is then stored in it.
+static optional_ptr<PhysicalTableScan> FindProbeScan(PhysicalOperator &op, vector<idx_t> &columns,
+                                                     optional_ptr<optional_ptr<PhysicalHashJoin>> build_join) {
+	switch (op.type) {
+	case PhysicalOperatorType::TABLE_SCAN:
+		return &op.Cast<PhysicalTableScan>();
+	case PhysicalOperatorType::FILTER:
+		return FindProbeScan(*op.children[0], columns, build_join);
+	case PhysicalOperatorType::PROJECTION: {
+		auto &projection = op.Cast<PhysicalProjection>();
+		for (auto &column : columns) {
+			auto &expr = *projection.select_list[column];
+			if (expr.type != ExpressionType::BOUND_REF) {
+				return nullptr;
+			}
+			column = expr.Cast<BoundReferenceExpression>().index;
+		}
+		return FindProbeScan(*op.children[0], columns, build_join);
+	}
+	case PhysicalOperatorType::HASH_JOIN: {
+		// the output of a hash join starts with the columns of its probe side
+		auto &join = op.Cast<PhysicalHashJoin>();
+		const auto probe_column_count = op.children[0]->types.size();
+		idx_t probe_columns = 0;
+		for (auto &column : columns) {
+			probe_columns += column < probe_column_count;
+		}
+		if (probe_columns == columns.size()) {
+			return FindProbeScan(*op.children[0], columns, build_join);
+		}
+		// the build columns of an inner join can be followed into its build side, as dropping a build tuple only drops
+		// the output tuples that it would produce. A cached hash table must hold all build tuples though.
+		if (probe_columns != 0 || !build_join || *build_join || join.join_type != JoinType::INNER ||
+		    !join.cache_key.empty() || op.types.size() != probe_column_count + join.build_types.size()) {
+			return nullptr;
+		}
+		for (auto &column : columns) {
+			column -= probe_column_count;
+			if (!join.right_projection_map.empty()) {
+				column = join.right_projection_map[column];
+			}
+		}
+		*build_join = &join;
+		return FindProbeScan(*op.children[1], columns, nullptr);
+	}
+	default:
+		return nullptr;
+	}
+}
+
+//! Lets the table scan on the probe side of the hash join drop the tuples that cannot find a match. With sideways
+//! filters, the table scan may also be on the build side of a hash join below in the pipeline, which then only starts
+//! its build once this join is built.
+static void PlanRuntimeFilter(PhysicalHashJoin &join, bool sideways) {
+	switch (join.join_type) {
+	case JoinType::INNER:
+	case JoinType::SEMI:
+	case JoinType::RIGHT:
+		// probe tuples without a match are not part of the result
+		break;
+	default:
+		return;
+	}
+	vector<LogicalType> key_types;
+	vector<idx_t> columns;
+	for (auto &cond : join.conditions) {
+		if (cond.comparison != ExpressionType::COMPARE_EQUAL &&
+		    cond.comparison != ExpressionType::COMPARE_NOT_DISTINCT_FROM) {
+			// the hash table only hashes the equality conditions, which come first
+			break;
+		}
+		if (cond.comparison != ExpressionType::COMPARE_EQUAL || cond.left->type != ExpressionType::BOUND_REF) {
+			// NULL keys can match, or the probe key is computed
+			return;
+		}
+		key_types.push_back(cond.left->return_type);
+		columns.push_back(cond.left->Cast<BoundReferenceExpression>().index);
+	}
+	optional_ptr<PhysicalHashJoin> build_join;
+	auto scan = FindProbeScan(*join.children[0], columns, sideways ? &build_join : nullptr);
+	if (!scan) {
+		return;
+	}
+	join.runtime_filter = make_shared<JoinRuntimeFilter>(std::move(key_types), std::move(columns));
+	scan->runtime_filters.push_back(join.runtime_filter);
+	if (build_join) {
+		build_join->build_dependencies.push_back(join);
+	}
+}
+
+//! Appends the fingerprint of the expression to the key, returns false if the expression can give different results
+//! for the same input
+static bool FingerprintExpression(Expression &expr, string &key) {
+	if (expr.HasSideEffects() || expr.HasParameter()) {
+		return false;
+	}
+	// the aliases of column references are column names, which do not identify the column
+	auto copy = expr.Copy();
+	ExpressionIterator::EnumerateExpression(copy, [&](Expression &child) { child.alias.clear(); });
+	key += copy->ToString() + "::" + expr.return_type.ToString() + ";";
+	return true;
+}
+
+//! Appends the fingerprint of the build side of a hash join to the key, and collects the tables it scans. Returns
+//! false if the build side does more than scanning, filtering and projecting base tables.
+static bool FingerprintBuildSide(PhysicalOperator &op, string &key, vector<shared_ptr<DataTableInfo>> &tables) {
+	key += PhysicalOperatorToString(op.type) + "(";
+	for (auto &type : op.types) {
+		key += type.ToString() + ",";
+	}
+	switch (op.type) {
+	case PhysicalOperatorType::TABLE_SCAN: {
+		auto &scan = op.Cast<PhysicalTableScan>();
+		if (scan.function.name != "seq_scan" || !scan.runtime_filters.empty()) {
+			return false;
+		}
+		auto &bind_data = scan.bind_data->Cast<TableScanBindData>();
+		if (bind_data.is_index_scan) {
+			return false;
+		}
+		auto &table = bind_data.table.GetStorage();
+		key += table.info->schema + "." + table.info->table + ":";
+		for (auto &column_id : scan.column_ids) {
+			key += to_string(column_id) + ",";
+		}
+		key += ":";
+		for (auto &projection_id : scan.projection_ids) {
+			key += to_string(projection_id) + ",";
+		}
+		if (scan.table_filters) {
+			// the filters are ordered by column, as the map of the filter set is not
+			map<idx_t, string> filters;
+			for (auto &filter : scan.table_filters->filters) {
+				filters[filter.first] = filter.second->ToString(to_string(filter.first));
+			}
+			for (auto &filter : filters) {
+				key += ":" + filter.second;
+			}
+		}
+		tables.push_back(table.info);
+		break;
+	}
+	case PhysicalOperatorType::FILTER:
+		if (!FingerprintExpression(*op.Cast<PhysicalFilter>().expression, key)) {
+			return false;
+		}
+		break;
+	case PhysicalOperatorType::PROJECTION:
+		for (auto &expr : op.Cast<PhysicalProjection>().select_list) {
+			if (!FingerprintExpression(*expr, key)) {
+				return false;
+			}
+		}
+		break;
+	default:
+		return false;
+	}
+	for (auto &child : op.children) {
+		if (!FingerprintBuildSide(*child, key, tables)) {
+			return false;
+		}
+	}
+	key += ")";
+	return true;
+}
+
+//! Lets the hash join take its hash table from the JoinHashTableCache if another query built it over the same tables
+static void PlanHashTableCache(PhysicalHashJoin &join) {
+	switch (join.join_type) {
+	case JoinType::INNER:
+	case JoinType::LEFT:
+	case JoinType::SEMI:
+	case JoinType::ANTI:
+	case JoinType::MARK:
+		// the probes of these joins do not write to the hash table
+		break;
+	default:
+		return;
+	}
+	if (!join.delim_types.empty()) {
+		// the hash table of a correlated MARK join holds aggregates of the query
+		return;
+	}
+	string key = JoinTypeToString(join.join_type) + (join.linear_probing ? ":linear" : ":chained") + ":";
+	for (auto &cond : join.conditions) {
+		key += ExpressionTypeToOperator(cond.comparison);
+		if (!FingerprintExpression(*cond.right, key)) {
+			return;
+		}
+	}
+	for (auto &column : join.right_projection_map) {
+		key += to_string(column) + ",";
+	}
+	vector<shared_ptr<DataTableInfo>> tables;
+	if (!FingerprintBuildSide(*join.children[1], key, tables)) {
+		return;
+	}
+	join.cache_key = std::move(key);
+	join.cache_tables = std::move(tables);
+}
+
 static bool CanPlanIndexJoin(ClientContext &context, TableScanBindData &bind_data, PhysicalTableScan &scan) {
 	auto &table = bind_data.table;
 	auto &transaction = DuckTransaction::Get(context, table.catalog);
@@ -135,6 +387,92 @@ void CheckForPerfectJoinOpt(LogicalComparisonJoin &op, PerfectHashJoinStats &joi
 	return;
 }
 
+//! Returns the narrowest integer type that holds the keys of both sides of an equality condition, or INVALID
+static LogicalType GetCompressedKeyType(const BaseStatistics &stats) {
+	const auto &type = stats.GetType();
+	if (type.IsIntegral()) {
+		if (GetTypeIdSize(type.InternalType()) == 1 || !NumericStats::HasMinMax(stats)) {
+			return LogicalType::INVALID;
+		}
+		auto min_value = NumericStats::Min(stats);
+		auto max_value = NumericStats::Max(stats);
+		hugeint_t hugeint_range;
+		uint64_t range;
+		if (!min_value.DefaultTryCastAs(LogicalType::HUGEINT) || !max_value.DefaultTryCastAs(LogicalType::HUGEINT) ||
+		    !TrySubtractOperator::Operation(max_value.GetValue<hugeint_t>(), min_value.GetValue<hugeint_t>(),
+		                                    hugeint_range) ||
+		    !Hugeint::TryCast(hugeint_range, range)) {
+			return LogicalType::INVALID;
+		}
+		LogicalType compressed_type;
+		if (range <= NumericLimits<uint8_t>::Maximum()) {
+			compressed_type = LogicalType::UTINYINT;
+		} else if (range <= NumericLimits<uint16_t>::Maximum()) {
+			compressed_type = LogicalType::USMALLINT;
+		} else if (range <= NumericLimits<uint32_t>::Maximum()) {
+			compressed_type = LogicalType::UINTEGER;
+		} else {
+			compressed_type = LogicalType::UBIGINT;
+		}
+		if (GetTypeIdSize(compressed_type.InternalType()) < GetTypeIdSize(type.InternalType())) {
+			return compressed_type;
+		}
+	} else if (type.id() == LogicalTypeId::VARCHAR && StringStats::HasMaxStringLength(stats)) {
+		// strings shorter than the integer are packed into it, which keeps them distinct
+		for (const auto &compressed_type : CompressedMaterializationFunctions::StringTypes()) {
+			if (StringStats::MaxStringLength(stats) < GetTypeIdSize(compressed_type.InternalType())) {
+				return compressed_type;
+			}
+		}
+	}
+	return LogicalType::INVALID;
+}
+
+//! Replaces the keys of the equality conditions by narrower integers that the hash table hashes and compares faster.
+//! Both sides of a condition are compressed with the same function, so that equal keys remain equal.
+//! Returns whether any of the keys was compressed.
+static bool PlanKeyCompression(LogicalComparisonJoin &op) {
+	if (op.join_stats.size() != 2 * op.conditions.size()) {
+		// the statistics of some conditions are missing, so we cannot tell which statistics belong to which condition
+		return false;
+	}
+	bool compressed = false;
+	for (idx_t cond_idx = 0; cond_idx < op.conditions.size(); cond_idx++) {
+		auto &cond = op.conditions[cond_idx];
+		if (cond.comparison != ExpressionType::COMPARE_EQUAL &&
+		    cond.comparison != ExpressionType::COMPARE_NOT_DISTINCT_FROM) {
+			continue;
+		}
+		auto &stats_left = *op.join_stats[2 * cond_idx];
+		auto &stats_right = *op.join_stats[2 * cond_idx + 1];
+		const auto &type = cond.left->return_type;
+		if (type != cond.right->return_type || type != stats_left.GetType() || type != stats_right.GetType()) {
+			continue;
+		}
+		// the keys of both sides must fit into the compressed type
+		auto stats = stats_left.Copy();
+		stats.Merge(stats_right);
+		auto compressed_type = GetCompressedKeyType(stats);
+		if (compressed_type == LogicalType::INVALID) {
+			continue;
+		}
+		ScalarFunction compress_function = type.IsIntegral()
+		                                       ? CMIntegralCompressFun::GetFunction(type, compressed_type)
+		                                       : CMStringCompressFun::GetFunction(compressed_type);
+		for (auto key : {&cond.left, &cond.right}) {
+			vector<unique_ptr<Expression>> arguments;
+			arguments.push_back(std::move(*key));
+			if (type.IsIntegral()) {
+				arguments.push_back(make_uniq<BoundConstantExpression>(NumericStats::Min(stats)));
+			}
+			*key = make_uniq<BoundFunctionExpression>(compressed_type, compress_function, std::move(arguments),
+			                                          nullptr);
+		}
+		compressed = true;
+	}
+	return compressed;
+}
+
 static optional_ptr<Index> CanUseIndexJoin(TableScanBindData &tbl, Expression &expr) {
 	optional_ptr<Index> result;
 	tbl.table.GetStorage().info->indexes.Scan([&](Index &index) {
@@ -300,12 +638,45 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::PlanComparisonJoin(LogicalCo
 
 	unique_ptr<PhysicalOperator> plan;
 	if (has_equality && !prefer_range_joins) {
+		// check if we can use an index join
+		if (PlanIndexJoin(context, op, plan, left, right)) {
+			return plan;
+		}
 		// Equality join with small number of keys : possible perfect join optimization
 		PerfectHashJoinStats perfect_join_stats;
-		CheckForPerfectJoinOpt(op, perfect_join_stats);
+		if (ClientConfig::GetConfig(context).enable_perfect_hash_join) {
+			CheckForPerfectJoinOpt(op, perfect_join_stats);
+		}
+		// the delim join already materializes the probe side of its hash join
+		if (ClientConfig::GetConfig(context).enable_join_early_probe &&
+		    op.type != LogicalOperatorType::LOGICAL_DELIM_JOIN) {
+			PlanEarlyProbe(left);
+		}
+		// the perfect hash join indexes its table with the uncompressed build keys, so it is preferred if enabled
+		auto &client_config = ClientConfig::GetConfig(context);
+		if (client_config.enable_join_key_compression && !perfect_join_stats.is_build_small &&
+		    op.type != LogicalOperatorType::LOGICAL_DELIM_JOIN) {
+			PlanKeyCompression(op);
+		}
 		plan = make_uniq<PhysicalHashJoin>(op, std::move(left), std::move(right), std::move(op.conditions),
 		                                   op.join_type, op.left_projection_map, op.right_projection_map,
 		                                   std::move(op.mark_types), op.estimated_cardinality, perfect_join_stats);
+		plan->Cast<PhysicalHashJoin>().linear_probing = ClientConfig::GetConfig(context).enable_linear_probing_join;
+		if (ClientConfig::GetConfig(context).enable_breaker_reorder) {
+			PlanBreakerReorder(plan->Cast<PhysicalHashJoin>());
+		}
+		// the probe side of a delim join is moved below the delim join, so it is not scanned into the probe
+		if (ClientConfig::GetConfig(context).enable_join_runtime_filter &&
+		    op.type != LogicalOperatorType::LOGICAL_DELIM_JOIN) {
+			PlanRuntimeFilter(plan->Cast<PhysicalHashJoin>(),
+			                  ClientConfig::GetConfig(context).enable_join_sideways_filter);
+		}
+		auto &disabled_optimizers = DBConfig::GetConfig(context).options.disabled_optimizers;
+		if (ClientConfig::GetConfig(context).enable_hash_table_cache &&
+		    op.type != LogicalOperatorType::LOGICAL_DELIM_JOIN &&
+		    disabled_optimizers.find(OptimizerType::CACHE_HASH_TABLE) == disabled_optimizers.end()) {
+			PlanHashTableCache(plan->Cast<PhysicalHashJoin>());
+		}
 	} else {
 		static constexpr const idx_t NESTED_LOOP_JOIN_THRESHOLD = 5;
 		if (left->estimated_cardinality <= NESTED_LOOP_JOIN_THRESHOLD ||
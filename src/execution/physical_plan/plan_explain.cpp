@@ -1,5 +1,6 @@
 #include "duckdb/common/tree_renderer.hpp"
 #include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/execution/compaction_placement.hpp"
 #include "duckdb/execution/operator/helper/physical_explain_analyze.hpp"
 #include "duckdb/execution/operator/scan/physical_column_data_scan.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
@@ -18,6 +19,10 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalExplain &o
 		return std::move(result);
 	}
 
+	// the plan is rendered before the generator places compaction, so place it here to show the decisions
+	if (ClientConfig::GetConfig(context).enable_compaction_placement) {
+		CompactionPlacement::Place(*plan);
+	}
 	op.physical_plan = plan->ToString();
 	// the output of the explain
 	vector<string> keys, values;
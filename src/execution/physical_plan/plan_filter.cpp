@@ -1,8 +1,11 @@
 #include "duckdb/execution/operator/filter/physical_filter.hpp"
+#include "duckdb/execution/operator/join/physical_hash_join.hpp"
 #include "duckdb/execution/operator/projection/physical_projection.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/optimizer/matcher/expression_matcher.hpp"
+#include "duckdb/main/client_context.hpp"
 #include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/operator/logical_filter.hpp"
@@ -13,6 +16,25 @@ namespace duckdb {
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalFilter &op) {
 	D_ASSERT(op.children.size() == 1);
 	unique_ptr<PhysicalOperator> plan = CreatePlan(*op.children[0]);
+	if (!op.expressions.empty() && plan->type == PhysicalOperatorType::HASH_JOIN &&
+	    ClientConfig::GetConfig(context).enable_join_late_materialization) {
+		// the hash join resolves the filter before it gathers the build columns that the filter does not read
+		unique_ptr<Expression> filter;
+		if (op.expressions.size() > 1) {
+			auto conjunction = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
+			for (auto &expr : op.expressions) {
+				conjunction->children.push_back(std::move(expr));
+			}
+			filter = std::move(conjunction);
+		} else {
+			filter = std::move(op.expressions[0]);
+		}
+		op.expressions.clear();
+		auto &join = plan->Cast<PhysicalHashJoin>();
+		if (!join.AddFilter(filter)) {
+			op.expressions.push_back(std::move(filter));
+		}
+	}
 	if (!op.expressions.empty()) {
 		D_ASSERT(plan->types.size() > 0);
 		// create a filter if there is anything to filter
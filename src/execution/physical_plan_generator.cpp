@@ -3,6 +3,7 @@
 #include "duckdb/catalog/catalog_entry/scalar_function_catalog_entry.hpp"
 #include "duckdb/common/types/column/column_data_collection.hpp"
 #include "duckdb/execution/column_binding_resolver.hpp"
+#include "duckdb/execution/compaction_placement.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/config.hpp"
 #include "duckdb/main/query_profiler.hpp"
@@ -59,6 +60,13 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(unique_ptr<Logica
 	auto plan = CreatePlan(*op);
 	profiler.EndPhase();
 
+	// decide for which compacting operators compaction pays off
+	if (ClientConfig::GetConfig(context).enable_compaction_placement) {
+		profiler.StartPhase("compaction_placement");
+		CompactionPlacement::Place(*plan);
+		profiler.EndPhase();
+	}
+
 	plan->Verify();
 	return plan;
 }
@@ -0,0 +1,135 @@
+#include "duckdb/function/table/system_functions.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/query_profiler.hpp"
+
+namespace duckdb {
+
+struct ChunkStatsEntry {
+	ChunkStatsEntry(idx_t operator_id, string name, const ChunkStatistics &stats)
+	    : operator_id(operator_id), name(std::move(name)), stats(stats) {
+	}
+
+	idx_t operator_id;
+	string name;
+	ChunkStatistics stats;
+};
+
+struct DuckDBChunkStatsData : public GlobalTableFunctionState {
+	DuckDBChunkStatsData() : offset(0) {
+	}
+
+	vector<ChunkStatsEntry> entries;
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> DuckDBChunkStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("operator_id");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("operator_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("input_chunks");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("input_tuples");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("input_histogram");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::BIGINT));
+
+	names.emplace_back("output_chunks");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("output_tuples");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("output_histogram");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::BIGINT));
+
+	names.emplace_back("buffer_flushes");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("tuples_copied");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	return nullptr;
+}
+
+//! Numbers the operators of the profiled query in pre-order, as EXPLAIN ANALYZE renders them top-down
+static void AddEntries(const QueryProfiler::TreeNode &node, vector<ChunkStatsEntry> &entries) {
+	entries.emplace_back(entries.size() + 1, node.name, node.info.chunk_stats);
+	for (auto &child : node.children) {
+		AddEntries(*child, entries);
+	}
+}
+
+unique_ptr<GlobalTableFunctionState> DuckDBChunkStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<DuckDBChunkStatsData>();
+
+	// report the statistics of the last profiled query that ran operators, statements such as CREATE TABLE do not
+	auto &prev_profilers = ClientData::Get(context).query_profiler_history->GetPrevProfilers();
+	for (auto it = prev_profilers.rbegin(); it != prev_profilers.rend(); it++) {
+		auto root = it->second->GetRoot();
+		if (root) {
+			AddEntries(*root, result->entries);
+			break;
+		}
+	}
+	return std::move(result);
+}
+
+static Value HistogramValue(const array<idx_t, ChunkStatistics::HISTOGRAM_BUCKETS> &histogram) {
+	vector<Value> buckets;
+	for (auto &count : histogram) {
+		buckets.push_back(Value::BIGINT(count));
+	}
+	return Value::LIST(LogicalType::BIGINT, std::move(buckets));
+}
+
+void DuckDBChunkStatsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<DuckDBChunkStatsData>();
+	if (data.offset >= data.entries.size()) {
+		// finished returning values
+		return;
+	}
+	// start returning values
+	// either fill up the chunk or return all the remaining columns
+	idx_t count = 0;
+	while (data.offset < data.entries.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = data.entries[data.offset++];
+		auto &stats = entry.stats;
+		// return values:
+		idx_t col = 0;
+		// operator_id, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(entry.operator_id));
+		// operator_name, VARCHAR
+		output.SetValue(col++, count, entry.name);
+		// input_chunks, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.input_chunks));
+		// input_tuples, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.input_tuples));
+		// input_histogram, BIGINT[]
+		output.SetValue(col++, count, HistogramValue(stats.input_histogram));
+		// output_chunks, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.output_chunks));
+		// output_tuples, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.output_tuples));
+		// output_histogram, BIGINT[]
+		output.SetValue(col++, count, HistogramValue(stats.output_histogram));
+		// buffer_flushes, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.buffer_flushes));
+		// tuples_copied, BIGINT
+		output.SetValue(col++, count, Value::BIGINT(stats.tuples_copied));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void DuckDBChunkStatsFun::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(
+	    TableFunction("duckdb_chunk_stats", {}, DuckDBChunkStatsFunction, DuckDBChunkStatsBind, DuckDBChunkStatsInit));
+}
+
+} // namespace duckdb
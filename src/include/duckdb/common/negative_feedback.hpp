@@ -8,12 +8,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cmath>
 #include <filesystem>
-#include <random>
+#include <fstream>
+#include <iostream>
 
 #include "duckdb/common/chrono.hpp"
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/to_string.hpp"
+#include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
 
@@ -33,8 +38,6 @@ public:
 
 	// Selects an arm based on the UCB1 algorithm
 	inline size_t SelectArm() {
-		std::lock_guard<std::mutex> lock(mutex_);
-
 		if (n_start_sampling_ < kArms_ * kStartSampling) {
 			// initialize experimental means by pulling each arm once
 			size_t arm = n_start_sampling_ % kArms_;
@@ -63,8 +66,6 @@ public:
 
 	// Updates the arm with the given weight
 	inline void UpdateArm(size_t arm, double reward) {
-		std::lock_guard<std::mutex> lock(mutex_);
-
 		if (select_times_ % kHeart == 0 && n_start_sampling_ >= kArms_ * kStartSampling) {
 			history_.emplace_back(est_rewards_, n_select_);
 
@@ -78,6 +79,7 @@ public:
 
 				stage_update_times_ = 0;
 				std::fill_n(stage_n_update_.begin(), kArms_, 0);
+				restarts_++;
 			}
 		}
 
@@ -90,6 +92,18 @@ public:
 		stage_n_update_[arm]++;
 	}
 
+	// Moves the estimated reward of the arm towards the given mean, keeping the estimated variance unchanged
+	inline void MergeReward(size_t arm, double mean) {
+		double merged = stage_n_update_[arm] == 0 ? mean : (est_rewards_[arm] + mean) / 2;
+		est_square_rewards_[arm] += merged * merged - est_rewards_[arm] * est_rewards_[arm];
+		est_rewards_[arm] = merged;
+	}
+
+	// Returns how often the bandit detected a shift in the rewards and restarted its estimates
+	inline size_t Restarts() const {
+		return restarts_;
+	}
+
 	inline void Print(const std::vector<size_t> &values) {
 		for (size_t i = 0; i < est_rewards_.size(); i++) {
 			std::cerr << " [PARAMETERS] Estimated reward for arm " << values[i] << " is " << to_string(est_rewards_[i])
@@ -140,7 +154,6 @@ private:
 
 private:
 	// UCB-tuned
-	std::mutex mutex_;
 	std::vector<double> est_rewards_;
 	std::vector<double> est_square_rewards_;
 	size_t stage_update_times_;
@@ -149,6 +162,7 @@ private:
 	// restart
 	size_t n_start_sampling_ = 0;
 	std::vector<double> r_means_;
+	size_t restarts_ = 0;
 
 private:
 	// logging
@@ -163,100 +177,161 @@ private:
 	std::vector<Record> history_;
 };
 
-class CompactTuner {
+//! The reward estimates of one compacting operator, shared by the bandits of all threads running the operator.
+//! When a bandit restarts after a shift in the rewards, the estimates start a new epoch, so that the rewards received
+//! before the shift are not merged back into the restarted bandits.
+class SharedBanditEstimates {
 public:
-	static CompactTuner &Get() {
-		static CompactTuner instance;
-		return instance;
+	explicit SharedBanditEstimates(size_t n_arms) : reward_sums_(n_arms), n_updates_(n_arms), epoch_(0) {
 	}
 
-	inline void Initialize(size_t address, const std::vector<size_t> &arms = {32, 64, 128, 256, 384, 512, 768, 1024}) {
-		D_ASSERT(package_index_.count(address) == 0);
-
-		package_index_[address] = bandit_packages_.size();
-		bandit_packages_.emplace_back(arms, std::vector<double>(arms.size(), 0));
+	// Returns the current epoch of the estimates
+	inline size_t Epoch() const {
+		return epoch_.load(std::memory_order_acquire);
 	}
 
-	// Selects an arm based on the UCB1 algorithm
-	inline size_t SelectArm(idx_t id) {
-		auto &bandit = bandit_packages_[id].bandit;
-		auto &value = bandit_packages_[id].value;
-
-		size_t ret = value[bandit->SelectArm()];
-		return ret;
+	// Discards the estimates of the given epoch and starts the next one. Does nothing if another thread already did.
+	inline void Restart(size_t epoch) {
+		if (!epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel)) {
+			return;
+		}
+		for (size_t i = 0; i < reward_sums_.size(); i++) {
+			reward_sums_[i].store(0, std::memory_order_relaxed);
+			n_updates_[i].store(0, std::memory_order_relaxed);
+		}
 	}
 
-	// Updates the arm with the given weight
-	inline void UpdateArm(idx_t id, size_t arm, double reward) {
-		auto &bandit = bandit_packages_[id].bandit;
-		auto &value_index = bandit_packages_[id].value_index;
+	// Adds the rewards an arm received on one thread since its last merge, without taking a lock. The rewards are
+	// dropped if they were received in an earlier epoch.
+	inline void Publish(size_t epoch, size_t arm, double reward_sum, size_t n_updates) {
+		if (epoch != Epoch()) {
+			return;
+		}
+		auto current = reward_sums_[arm].load(std::memory_order_relaxed);
+		while (!reward_sums_[arm].compare_exchange_weak(current, current + reward_sum, std::memory_order_relaxed)) {
+		}
+		n_updates_[arm].fetch_add(n_updates, std::memory_order_relaxed);
+	}
 
-		if (value_index.count(arm) == 0) return;
-		bandit->UpdateArm(value_index[arm], reward);
+	// Returns the mean reward of an arm over all threads, or a negative value if no thread has updated it yet
+	inline double Mean(size_t arm) const {
+		auto n_updates = n_updates_[arm].load(std::memory_order_relaxed);
+		if (n_updates == 0) return -1;
+		return reward_sums_[arm].load(std::memory_order_relaxed) / n_updates;
 	}
 
-	inline void Reset() {
-		if (!bandit_packages_.empty()) {
-			// output the parameters
-			std::cerr << "-------\n";
-
-			std::string folder_name = "./bandit_log_0x" + std::to_string(RandomInteger());
-			std::filesystem::create_directories(folder_name);
-			for (auto &pair : package_index_) {
-				auto &addr = pair.first;
-				auto &id = pair.second;
-
-				auto &bandit = bandit_packages_[id].bandit;
-				auto &value = bandit_packages_[id].value;
-
-				std::string bandit_name = "0x" + std::to_string(addr) + "\tId-" + std::to_string(id);
-				std::cerr << " [PARAMETERS] Compaction Address - " << bandit_name << "\n";
-				bandit->Log2Csv("./" + folder_name + "/" + bandit_name + ".log");
-				bandit->Print(value);
-			}
+private:
+	std::vector<std::atomic<double>> reward_sums_;
+	std::vector<std::atomic<size_t>> n_updates_;
+	std::atomic<size_t> epoch_;
+};
 
-			package_index_.clear();
-			bandit_packages_.clear();
+//! The thread-local bandit of a compacting operator, together with the compaction thresholds (arms) it chooses from.
+//! Every kMergeInterval updates, its rewards are merged with the estimates of the other threads.
+class BanditPackage {
+public:
+	BanditPackage(SharedBanditEstimates &shared, const std::vector<size_t> &arms)
+	    : value(arms), shared_(shared), epoch_(shared.Epoch()), pending_sums_(arms.size(), 0),
+	      pending_updates_(arms.size(), 0) {
+		bandit = make_uniq<MultiArmedBandit>(arms.size(), std::vector<double>(arms.size(), 0));
+		for (size_t i = 0; i < arms.size(); i++) {
+			value_index[arms[i]] = i;
 		}
 	}
 
-	inline int64_t GetId(size_t address) {
-		if (package_index_.count(address) == 0) {
-			// not found
-			return -1;
+	// Selects a compaction threshold based on the UCB1 algorithm
+	inline size_t SelectArm() {
+		return value[bandit->SelectArm()];
+	}
+
+	// Updates the compaction threshold with the given reward
+	inline void UpdateArm(size_t arm, double reward) {
+		auto entry = value_index.find(arm);
+		if (entry == value_index.end()) return;
+		auto restarts = bandit->Restarts();
+		bandit->UpdateArm(entry->second, reward);
+		if (bandit->Restarts() != restarts) {
+			// the rewards shifted: the estimates of all threads are stale
+			shared_.Restart(epoch_);
+			StartEpoch();
 		}
 
-		return package_index_[address];
+		pending_sums_[entry->second] += reward;
+		pending_updates_[entry->second]++;
+		if (++n_updates_ % kMergeInterval == 0) {
+			Merge();
+		}
 	}
 
-	inline size_t GetBanditSize() {
-		return bandit_packages_.size();
-	}
+	unique_ptr<MultiArmedBandit> bandit;
+	std::vector<size_t> value;
+	std::unordered_map<size_t, idx_t> value_index;
 
 private:
-	inline size_t RandomInteger() {
-		return integers(gen_);
+	// Drops the rewards that were not published yet, and follows the current epoch of the shared estimates
+	inline void StartEpoch() {
+		epoch_ = shared_.Epoch();
+		std::fill(pending_sums_.begin(), pending_sums_.end(), 0);
+		std::fill(pending_updates_.begin(), pending_updates_.end(), 0);
 	}
 
-	struct BanditPackage {
-		std::unique_ptr<MultiArmedBandit> bandit;
-		std::vector<size_t> value;
-		std::unordered_map<size_t, idx_t> value_index;
-
-		BanditPackage(const std::vector<size_t> &arms, const std::vector<double> &means) {
-			bandit = make_uniq<MultiArmedBandit>(arms.size(), means);
-			value = arms;
-			for (size_t i = 0; i < arms.size(); i++) {
-				value_index[arms[i]] = i;
+	// Publishes the rewards of this thread and pulls in the estimates of all threads
+	inline void Merge() {
+		if (shared_.Epoch() != epoch_) {
+			// another thread restarted the estimates: the rewards of this thread predate the shift
+			StartEpoch();
+		}
+		for (size_t i = 0; i < value.size(); i++) {
+			if (pending_updates_[i] > 0) {
+				shared_.Publish(epoch_, i, pending_sums_[i], pending_updates_[i]);
+				pending_sums_[i] = 0;
+				pending_updates_[i] = 0;
+			}
+			auto mean = shared_.Mean(i);
+			if (mean >= 0) {
+				bandit->MergeReward(i, mean);
 			}
 		}
-	};
+	}
+
+	size_t kMergeInterval = 64;
+
+	SharedBanditEstimates &shared_;
+	//! The epoch of the shared estimates the pending rewards belong to
+	size_t epoch_;
+	std::vector<double> pending_sums_;
+	std::vector<size_t> pending_updates_;
+	size_t n_updates_ = 0;
+};
 
-	std::unordered_map<size_t, idx_t> package_index_;
-	std::vector<BanditPackage> bandit_packages_;
+//! The CompactTuner tunes the compaction thresholds of the compacting operators of one query. Each thread running a
+//! compacting operator gets its own bandit, so selecting and updating arms never takes a lock.
+class CompactTuner {
+public:
+	// Creates the bandit of a thread running the compacting operator at the given address
+	inline unique_ptr<BanditPackage> CreateBandit(size_t address, const std::vector<size_t> &arms = {32, 64, 128, 256,
+	                                                                                                384, 512, 768, 1024}) {
+		std::lock_guard<std::mutex> lock(mutex_);
 
-	// random
-	std::mt19937 gen_;
-	std::uniform_int_distribution<int> integers;
+		auto &shared = shared_estimates_[address];
+		if (!shared) {
+			shared = make_uniq<SharedBanditEstimates>(arms.size());
+		}
+		return make_uniq<BanditPackage>(*shared, arms);
+	}
+
+	inline void Reset() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		shared_estimates_.clear();
+	}
+
+	inline size_t GetBanditSize() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return shared_estimates_.size();
+	}
+
+private:
+	std::mutex mutex_;
+	std::unordered_map<size_t, unique_ptr<SharedBanditEstimates>> shared_estimates_;
 };
 }  // namespace duckdb
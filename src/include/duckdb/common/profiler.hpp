@@ -331,7 +331,7 @@ private:
 	std::uniform_int_distribution<int> integers;
 };
 
-// This profiler is to compute the chunk factor of each hash join operator
+// This profiler is to compute the chunk factor of each hash join operator, and the chunk sizes after compaction
 class HashJoinProfiler {
 public:
 	const static bool kEnableProfiling = false;
@@ -342,11 +342,12 @@ public:
 		return instance;
 	}
 
-	void InputChunk(uint64_t n_tuple, const string &join_addr) {
+	void InputChunk(uint64_t n_tuple, const string &join_addr, const string &join_type = "") {
 		if (!kEnableProfiling) return;
 		if (n_tuple == 0) return;
 
 		auto &info = GetJoinInfo(join_addr);
+		if (!join_type.empty()) info.join_type = join_type;
 		// update cardinality
 		++info.n_input_chunk;
 		++info.dist_input_size[n_tuple - 1];
@@ -369,25 +370,39 @@ public:
 		info.chunk_factors.push_back(factor);
 	}
 
+	// Records a chunk emitted downstream by the join, after the results of several probes have been compacted
+	void CompactedChunk(uint64_t n_tuple, const string &join_addr) {
+		if (!kEnableProfiling) return;
+		if (n_tuple == 0) return;
+
+		auto &info = GetJoinInfo(join_addr);
+		++info.n_compacted_chunk;
+		++info.dist_compacted_size[n_tuple - 1];
+	}
+
 	void PrintProfile() {
 		for (const auto &pair : joins_) {
 			const auto &join_name = pair.first;
 			const auto &info = pair.second;
 
-			uint64_t total_input = 0, total_output = 0;
+			uint64_t total_input = 0, total_output = 0, total_compacted = 0;
 			for (uint64_t i = 0; i < 2048; ++i) {
 				total_input += (i + 1) * info.dist_input_size[i];
 				total_output += (i + 1) * info.dist_output_size[i];
+				total_compacted += (i + 1) * info.dist_compacted_size[i];
 			}
 			double avg_input_tuple = total_input / double(info.n_input_chunk);
 			double avg_output_tuple = total_output / double(info.n_output_chunk);
+			double avg_compacted_tuple = total_compacted / double(info.n_compacted_chunk);
 			double chunk_factor = info.sum_chunk_factors / info.n_chunk_factor;
 
-			std::cerr << join_name << "\tChunk Factor: " << chunk_factor << "\n";
+			std::cerr << join_name << "\t" << info.join_type << "\tChunk Factor: " << chunk_factor << "\n";
 			std::cerr << "\tInput -- " << "#Tuple: " << total_input << "\t" << "#Chunk: " << info.n_input_chunk << "\t"
 			          << "Avg Size: " << avg_input_tuple << "\n";
 			std::cerr << "\tOutput -- " << "#Tuple: " << total_output << "\t" << "#Chunk: " << info.n_output_chunk
 			          << "\t" << "Avg Size: " << avg_output_tuple << "\n";
+			std::cerr << "\tCompacted -- " << "#Tuple: " << total_compacted << "\t" << "#Chunk: " << info.n_compacted_chunk
+			          << "\t" << "Avg Size: " << avg_compacted_tuple << "\n";
 			std::cerr << "\tData: [";
 			for (double factor : info.chunk_factors)
 				std::cerr << factor << ", ";
@@ -401,12 +416,18 @@ public:
 
 private:
 	struct VectorizedJoinInfo {
+		string join_type;
+
 		// cardinality
 		uint64_t n_input_chunk;
 		uint64_t n_output_chunk;
 		std::vector<uint64_t> dist_input_size;
 		std::vector<uint64_t> dist_output_size;
 
+		// cardinality after compaction
+		uint64_t n_compacted_chunk;
+		std::vector<uint64_t> dist_compacted_size;
+
 		// chunk factor
 		double sum_chunk_factors;
 		uint64_t n_chunk_factor;
@@ -417,6 +438,8 @@ private:
 		      n_output_chunk(0),
 		      dist_input_size(2048, 0),
 		      dist_output_size(2048, 0),
+		      n_compacted_chunk(0),
+		      dist_compacted_size(2048, 0),
 		      sum_chunk_factors(0),
 		      n_chunk_factor(0) {
 		}
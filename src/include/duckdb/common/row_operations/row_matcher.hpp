@@ -30,6 +30,11 @@ struct MatchFunction {
 	vector<MatchFunction> child_functions;
 };
 
+typedef idx_t (*key_match_function_t)(const vector<TupleDataVectorFormat> &lhs_formats, SelectionVector &sel,
+                                      const idx_t count, const TupleDataLayout &rhs_layout,
+                                      Vector &rhs_row_locations, SelectionVector *no_match_sel,
+                                      idx_t &no_match_count);
+
 struct RowMatcher {
 public:
 	using Predicates = vector<ExpressionType>;
@@ -55,9 +60,14 @@ private:
 	MatchFunction GetStructMatchFunction(const LogicalType &type, const ExpressionType predicate);
 	template <bool NO_MATCH_SEL>
 	MatchFunction GetListMatchFunction(const ExpressionType predicate);
+	//! Gets the specialized match function for the columns (if any)
+	key_match_function_t GetKeyMatchFunction(const bool no_match_sel, const TupleDataLayout &layout,
+	                                         const Predicates &predicates);
 
 private:
 	vector<MatchFunction> match_functions;
+	//! Matches all columns in a single pass, if there are one or two integer/UUID columns compared with EQUAL
+	key_match_function_t key_match_function = nullptr;
 };
 
 } // namespace duckdb
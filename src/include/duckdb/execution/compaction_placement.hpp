@@ -0,0 +1,29 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/compaction_placement.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/physical_operator.hpp"
+
+namespace duckdb {
+
+//! The CompactionPlacement pass runs after the PhysicalPlanGenerator and decides, based on the estimated
+//! cardinalities and the operator that consumes the output, for which compacting operators compaction pays off
+class CompactionPlacement {
+public:
+	//! Disables compaction for the compacting operators in the plan for which it is not expected to pay off
+	static void Place(PhysicalOperator &plan);
+
+private:
+	//! Visits the operator, whose output is consumed by the (effective) consumer at the given child index
+	static void Visit(PhysicalOperator &op, optional_ptr<PhysicalOperator> consumer, idx_t child_idx);
+	//! Decides whether compacting the output of the operator pays off, and records why
+	static void Decide(CompactingPhysicalOperator &op, optional_ptr<PhysicalOperator> consumer, idx_t child_idx);
+};
+
+} // namespace duckdb
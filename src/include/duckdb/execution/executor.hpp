@@ -17,6 +17,7 @@
 
 namespace duckdb {
 class ClientContext;
+class CompactTuner;
 class DataChunk;
 class PhysicalOperator;
 class PipelineExecutor;
@@ -99,6 +100,11 @@ public:
 	//! Returns true if all pipelines have been completed
 	bool ExecutionIsFinished();
 
+	//! Returns the tuner of the compaction thresholds of this query
+	CompactTuner &GetCompactTuner() {
+		return *compact_tuner;
+	}
+
 private:
 	void InitializeInternal(PhysicalOperator &physical_plan);
 
@@ -124,6 +130,8 @@ private:
 
 	mutex executor_lock;
 	mutex error_lock;
+	//! Tunes the compaction thresholds of the compacting operators in this query, outlives all operator states
+	unique_ptr<CompactTuner> compact_tuner;
 	//! All pipelines of the query plan
 	vector<shared_ptr<Pipeline>> pipelines;
 	//! The root pipelines of the query
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "duckdb/common/bit_utils.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/radix_partitioning.hpp"
 #include "duckdb/common/types/column/column_data_consumer.hpp"
@@ -17,6 +18,7 @@
 #include "duckdb/common/types/row/tuple_data_layout.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/execution/aggregate_hashtable.hpp"
+#include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/operator/logical_comparison_join.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
@@ -27,6 +29,24 @@ class BufferHandle;
 class ColumnDataCollection;
 struct ColumnDataAppendState;
 struct ClientConfig;
+class JoinRuntimeFilter;
+
+//! The thread-local state of a filter over the result of an inner join, which the probe resolves before it gathers
+//! the build columns that the filter does not read, so that these are only gathered for the tuples that pass
+struct JoinFilterState {
+	JoinFilterState(ClientContext &context, const Expression &filter, const vector<LogicalType> &result_types,
+	                const vector<bool> &build_columns);
+
+	ExpressionExecutor executor;
+	//! Holds the probe columns and the build columns that the filter reads
+	DataChunk chunk;
+	//! The rows of the chunk that pass the filter, in the order of the matches that pass
+	SelectionVector sel;
+	//! The matches that pass the filter
+	SelectionVector match_sel;
+	//! Whether the filter reads each of the build columns
+	const vector<bool> &build_columns;
+};
 
 struct JoinHTScanState {
 public:
@@ -71,16 +91,25 @@ public:
 		SelectionVector sel_vector;
 		// whether or not the given tuple has found a match
 		unsafe_unique_array<bool> found_match;
+		//! For linear probing: the slot of the current tuple of every probe, and the salt of its hash
+		unsafe_unique_array<idx_t> slots;
+		unsafe_unique_array<hash_t> salts;
 		JoinHashTable &ht;
 		bool finished;
 
-		// buffer
+		//! Thread-local chunk that holds the results of an inner join that did not fit in the result chunk
 		DataChunk *buffer;
 		SelectionVector target_vector;
+		//! The filter over the results of an inner join (if any)
+		optional_ptr<JoinFilterState> filter_state;
 
 		explicit ScanStructure(JoinHashTable &ht, TupleDataChunkState &key_state, DataChunk *buffer);
 		//! Get the next batch of data from the scan structure
 		void Next(DataChunk &keys, DataChunk &left, DataChunk &result);
+		//! Whether all results of the probe have been returned by Next
+		bool Finished() const {
+			return finished && !HasBuffer();
+		}
 
 	private:
 		//! Next operator for the inner join
@@ -105,6 +134,8 @@ public:
 		void ConstructMarkJoinResult(DataChunk &join_keys, DataChunk &child, DataChunk &result);
 
 		idx_t ScanInnerJoin(DataChunk &keys, SelectionVector &result_vector);
+		//! Resolves the filter over the matches of an inner join, returns how many matches pass it
+		idx_t ResolveFilter(DataChunk &left, SelectionVector &result_vector, idx_t result_count);
 
 		bool HasBuffer() const {
 			return buffer != nullptr && buffer->size() > 0;
@@ -119,7 +150,6 @@ public:
 		void GatherResult(Vector &result, const SelectionVector &sel_vector, const idx_t count, const idx_t col_idx);
 		idx_t ResolvePredicates(DataChunk &keys, SelectionVector &match_sel, SelectionVector *no_match_sel);
 	};
-	unique_ptr<DataChunk> buffer_;
 
 public:
 	JoinHashTable(BufferManager &buffer_manager, const vector<JoinCondition> &conditions,
@@ -139,10 +169,15 @@ public:
 	//! ever called.
 	void Finalize(idx_t chunk_idx_from, idx_t chunk_idx_to, bool parallel);
 	//! Probe the HT with the given input chunk, resulting in the given result
-	unique_ptr<ScanStructure> Probe(DataChunk &keys, TupleDataChunkState &key_state,
+	unique_ptr<ScanStructure> Probe(DataChunk &keys, TupleDataChunkState &key_state, DataChunk &buffer,
 	                                Vector *precomputed_hashes = nullptr);
 	//! Scan the HT to construct the full outer join result
 	void ScanFullOuter(JoinHTScanState &state, Vector &addresses, DataChunk &result);
+	//! Appends the addresses of the rows without a match to addresses (which holds found_entries already), until it
+	//! holds STANDARD_VECTOR_SIZE addresses or the scan is done. Returns the new number of addresses.
+	idx_t ScanFullOuterAddresses(JoinHTScanState &state, Vector &addresses, idx_t found_entries);
+	//! Gathers the rows of the found addresses into the full outer join result
+	void GatherFullOuter(Vector &addresses, idx_t found_entries, DataChunk &result);
 
 	//! Fill the pointer with all the addresses from the hashtable for full scan
 	idx_t FillWithHTOffsets(JoinHTScanState &state, Vector &addresses);
@@ -162,10 +197,17 @@ public:
 		return *data_collection;
 	}
 
+	//! The index of the first chunk of every partition in the data collection, followed by the chunk count (only set
+	//! if the partitions were combined with Unpartition)
+	const vector<idx_t> &GetPartitionChunkOffsets() const {
+		return partition_chunk_offsets;
+	}
+	//! Whether the partitions can be inserted into the pointer table by different threads without atomics, as the
+	//! entries of every partition are a contiguous range of the pointer table
+	bool CanFinalizePartitioned() const;
+
 	//! BufferManager
 	BufferManager &buffer_manager;
-	//! The join conditions
-	const vector<JoinCondition> &conditions;
 	//! The types of the keys used in equality comparison
 	vector<LogicalType> equality_types;
 	//! The types of the keys
@@ -195,6 +237,15 @@ public:
 	bool has_null;
 	//! Bitmask for getting relevant bits from the hashes to determine the position
 	uint64_t bitmask;
+	//! The shift that moves the bits of a hash that determine its position to the bottom (see BucketShift)
+	idx_t bucket_shift = 0;
+	//! Whether probes prefetch the pointer table entries and tuples of a vector before accessing them
+	bool prefetch_probe = false;
+	//! Whether the pointer table is an open-addressing table with linear probing, which holds one entry (with the
+	//! salt of its hash) per tuple, instead of the heads of the chains of tuples of each bucket
+	bool linear_probing = false;
+	//! The runtime filter whose Bloom filter is filled with the hashes of the build keys during finalize (if any)
+	optional_ptr<JoinRuntimeFilter> runtime_filter;
 
 	struct {
 		mutex mj_lock;
@@ -215,12 +266,13 @@ public:
 
 private:
 	unique_ptr<ScanStructure> InitializeScanStructure(DataChunk &keys, TupleDataChunkState &key_state,
-	                                                  const SelectionVector *&current_sel);
+	                                                  DataChunk &buffer, const SelectionVector *&current_sel);
 	void Hash(DataChunk &keys, const SelectionVector &sel, idx_t count, Vector &hashes);
 
-	//! Apply a bitmask to the hashes
-	void ApplyBitmask(Vector &hashes, idx_t count);
-	void ApplyBitmask(Vector &hashes, const SelectionVector &sel, idx_t count, Vector &pointers);
+	//! Looks up the chain of every hash in the pointer table, and sets its pointer to the first tuple of the chain,
+	//! or to nullptr if the chain is empty or its tag rules out a match. With linear probing, it instead sets the
+	//! pointer to the first tuple whose salt matches, and remembers its slot in the scan structure
+	void GetChainHeads(Vector &hashes, const SelectionVector &sel, idx_t count, ScanStructure &ss);
 
 private:
 	//! Insert the given set of locations into the HT with the given set of hashes
@@ -235,10 +287,13 @@ private:
 	unique_ptr<PartitionedTupleData> sink_collection;
 	//! The DataCollection holding the main data of the hash table
 	unique_ptr<TupleDataCollection> data_collection;
-	//! The hash map of the HT, created after finalization
+	//! The hash map of the HT, created after finalization. Every entry holds the pointer to the first tuple of its
+	//! chain in the lower 48 bits, and a 16-bit Bloom filter over the hashes of the chain in the upper 16 bits
 	AllocatedData hash_map;
 	//! Whether or not NULL values are considered equal in each of the comparisons
 	vector<bool> null_values_are_equal;
+	//! The chunk offsets of the partitions in the data collection
+	vector<idx_t> partition_chunk_offsets;
 
 	//! Copying not allowed
 	JoinHashTable(const JoinHashTable &) = delete;
@@ -308,6 +363,24 @@ public:
 	//! Total count
 	idx_t total_count;
 
+	//! Upper 16 bits of a pointer table entry are the tag
+	static constexpr const hash_t TAG_MASK = 0xFFFF000000000000;
+	//! Lower 48 bits of a pointer table entry are the pointer
+	static constexpr const hash_t POINTER_MASK = 0x0000FFFFFFFFFFFF;
+
+	//! The tag bit of a hash, selected by its upper 4 bits (the lower bits select the entry)
+	static inline hash_t ExtractTag(const hash_t &hash) {
+		return hash_t(1) << (48 + (hash >> 60));
+	}
+	//! The salt of a hash (with linear probing)
+	static inline hash_t ExtractSalt(const hash_t &hash) {
+		return hash & TAG_MASK;
+	}
+	//! The pointer to the first tuple of the chain of a pointer table entry
+	static inline data_ptr_t ExtractPointer(const hash_t &entry) {
+		return reinterpret_cast<data_ptr_t>(entry & POINTER_MASK);
+	}
+
 	//! Capacity of the pointer table given the ht count
 	//! (minimum of 1024 to prevent collision chance for small HT's)
 	static idx_t PointerTableCapacity(idx_t count) {
@@ -315,7 +388,14 @@ public:
 	}
 	//! Size of the pointer table (in bytes)
 	static idx_t PointerTableSize(idx_t count) {
-		return PointerTableCapacity(count) * sizeof(data_ptr_t);
+		return PointerTableCapacity(count) * sizeof(hash_t);
+	}
+	//! The position of a hash in a pointer table with the given capacity is given by the bits right below the tag,
+	//! i.e., (hash >> BucketShift(capacity)) & (capacity - 1). The upper bits of the position are then the radix
+	//! bits of the hash, so every radix partition of the build side owns a contiguous range of the pointer table.
+	static idx_t BucketShift(idx_t capacity) {
+		D_ASSERT(IsPowerOfTwo(capacity));
+		return RadixPartitioning::Shift(0) - CountZeros<uint64_t>::Trailing(capacity);
 	}
 
 	//! Whether we need to do an external join
@@ -330,14 +410,20 @@ public:
 	//! Build HT for the next partitioned probe round
 	bool PrepareExternalFinalize();
 	//! Probe whatever we can, sink the rest into a thread-local HT
-	unique_ptr<ScanStructure> ProbeAndSpill(DataChunk &keys, TupleDataChunkState &key_state, DataChunk &payload,
-	                                        ProbeSpill &probe_spill, ProbeSpillLocalAppendState &spill_state,
-	                                        DataChunk &spill_chunk);
+	unique_ptr<ScanStructure> ProbeAndSpill(DataChunk &keys, TupleDataChunkState &key_state, DataChunk &buffer,
+	                                        DataChunk &payload, ProbeSpill &probe_spill,
+	                                        ProbeSpillLocalAppendState &spill_state, DataChunk &spill_chunk);
 
 private:
+	//! Selects the partitions of the first round of an external join (see resident_partitions)
+	void PrepareResidentPartitions();
+
 	//! First and last partition of the current probe round
 	idx_t partition_start;
 	idx_t partition_end;
+	//! The partitions that are in the HT during the first round of an external join, in which the probe side is
+	//! probed while it streams through the pipeline (only the probe tuples of the other partitions are spilled)
+	vector<bool> resident_partitions;
 };
 
 }  // namespace duckdb
@@ -64,6 +64,10 @@ public:
 		return true;
 	}
 
+	bool SinkAcceptsFragments() const override {
+		return true;
+	}
+
 	bool SinkOrderDependent() const override {
 		return false;
 	}
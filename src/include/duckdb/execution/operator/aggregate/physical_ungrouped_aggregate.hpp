@@ -61,6 +61,10 @@ public:
 		return true;
 	}
 
+	bool SinkAcceptsFragments() const override {
+		return true;
+	}
+
 	bool SinkOrderDependent() const override;
 
 private:
@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/planner/expression.hpp"
 
 namespace duckdb {
 
@@ -25,6 +26,18 @@ public:
 	~PhysicalPipelineBreaker() override;
 
 	shared_ptr<ColumnDataAllocator> shared_allocator;
+	//! The join keys of the hash join that probes with the rows of the breaker. If set, the rows are grouped by the
+	//! region of the pointer table their hash falls in, so that consecutive probes touch nearby buckets
+	vector<unique_ptr<Expression>> reorder_keys;
+	//! The estimated capacity of the pointer table of that hash join
+	idx_t reorder_capacity = 0;
+
+	//! The number of radix bits the rows are grouped by when reordering
+	static constexpr const idx_t REORDER_RADIX_BITS = 8;
+
+public:
+	//! The number of partitions the rows are grouped into
+	idx_t PartitionCount() const;
 
 public:
 	// Sink interface
@@ -43,6 +56,10 @@ public:
 		return true;
 	}
 
+	bool SinkAcceptsFragments() const override {
+		return true;
+	}
+
 public:
 	// Source interface
 	unique_ptr<LocalSourceState> GetLocalSourceState(ExecutionContext &context,
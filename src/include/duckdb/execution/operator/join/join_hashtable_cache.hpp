@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/operator/join/join_hashtable_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+
+namespace duckdb {
+
+class JoinHashTable;
+struct DataTableInfo;
+
+//! A finalized hash table held by the JoinHashTableCache
+struct CachedJoinHashTable {
+	//! The hash table, which is only read by the probes of the joins that use it
+	shared_ptr<JoinHashTable> hash_table;
+	//! The range of every build key, for the runtime filter
+	vector<BaseStatistics> key_ranges;
+	//! The tables scanned by the build side, and the commit id of their latest change when they were scanned
+	vector<weak_ptr<DataTableInfo>> tables;
+	vector<transaction_t> versions;
+	//! The memory held by the hash table
+	idx_t size = 0;
+	//! When the hash table was last used (for the eviction)
+	idx_t last_use = 0;
+};
+
+//! The JoinHashTableCache keeps the hash tables of hash joins whose build side only scans, filters and projects base
+//! tables, so that later queries with the same build side over unchanged tables skip building them. Its entries are
+//! keyed by the fingerprint of the build side, and only used while the commit ids of the latest changes to the
+//! scanned tables are the same as when the hash table was built. The data of a cached hash table stays pinned in the
+//! buffer manager, so the cache holds at most a fraction of the memory limit, evicting the least recently used hash
+//! tables first.
+class JoinHashTableCache : public ObjectCacheEntry {
+public:
+	//! The fraction of the memory limit the cached hash tables may hold
+	static constexpr const double MAX_MEMORY_RATIO = 0.25;
+
+	static JoinHashTableCache &Get(ClientContext &context);
+
+	//! Gets the commit ids of the latest changes to the tables if the transaction of the context sees exactly those
+	//! changes (i.e. it started after them and did not change anything itself). Returns false otherwise.
+	static bool GetTableVersions(ClientContext &context, const vector<shared_ptr<DataTableInfo>> &tables,
+	                             vector<transaction_t> &versions);
+
+	//! Returns the hash table cached under the key, if it was built over the same tables at the same versions
+	shared_ptr<CachedJoinHashTable> Lookup(const string &key, const vector<shared_ptr<DataTableInfo>> &tables,
+	                                       const vector<transaction_t> &versions);
+	//! Adds a hash table to the cache, evicting the least recently used hash tables to stay within the memory limit
+	void Insert(const string &key, shared_ptr<CachedJoinHashTable> entry, idx_t max_memory);
+
+public:
+	static string ObjectType() {
+		return "join_hash_table_cache";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+private:
+	mutex lock;
+	unordered_map<string, shared_ptr<CachedJoinHashTable>> entries;
+	//! The memory held by all cached hash tables
+	idx_t memory_usage = 0;
+	//! Incremented on every lookup and insert (to order the entries by last use)
+	idx_t use_count = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/operator/join/join_runtime_filter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+
+namespace duckdb {
+
+//! The JoinRuntimeFilter is built by a hash join over the keys of its build side, and applied by the table scan on
+//! its probe side, so that tuples that cannot find a match are dropped before they are scanned into the pipeline.
+//! It consists of the range of every integral key and a blocked Bloom filter over the hashes of the keys.
+class JoinRuntimeFilter {
+public:
+	//! The number of Bloom filter bits reserved per build tuple
+	static constexpr const idx_t BITS_PER_KEY = 16;
+	//! The maximum number of (64-bit) blocks of the Bloom filter (16 MiB)
+	static constexpr const idx_t MAX_BLOCK_COUNT = 2097152;
+
+	JoinRuntimeFilter(vector<LogicalType> key_types, vector<idx_t> scan_columns);
+
+	//! The types of the equality keys of the join
+	vector<LogicalType> key_types;
+	//! For every key, the column of the scan output that holds the probe key
+	vector<idx_t> scan_columns;
+
+public:
+	//! Disables the filter, called before the build side is (re)built
+	void Reset();
+	//! Enables the filter, called once the build side is complete (the Bloom filter may still be filled until the
+	//! build side is finalized, which always happens before the probe side is scanned)
+	void Enable();
+	bool IsEnabled() const {
+		return enabled;
+	}
+
+	//! Whether the range of the key can be tracked
+	static bool SupportsRange(const LogicalType &type);
+	//! Updates the range of the key with the values in the vector
+	static void UpdateRange(BaseStatistics &range, Vector &keys, idx_t count);
+	//! Sets the range of the key that probe keys must fall into
+	void SetRange(idx_t key_idx, const BaseStatistics &range);
+
+	//! Allocates the Bloom filter for the given number of build tuples
+	void InitializeBloomFilter(idx_t count);
+	//! Adds the hashes of the build keys to the Bloom filter (thread-safe)
+	void InsertHashes(const hash_t hashes[], idx_t count);
+
+	//! Selects the tuples of the scanned chunk that can find a match, and returns how many there are
+	idx_t Select(DataChunk &chunk, Vector &hashes, SelectionVector &sel) const;
+
+private:
+	//! The Bloom filter bits that a hash sets in its block
+	static inline uint64_t BloomBits(hash_t hash) {
+		return (uint64_t(1) << ((hash >> 40) & 63)) | (uint64_t(1) << ((hash >> 46) & 63)) |
+		       (uint64_t(1) << ((hash >> 52) & 63));
+	}
+
+	//! Whether the scan applies the filter
+	bool enabled;
+	//! The bounds of every key (NULL if the range of the key is not tracked)
+	vector<Value> min_values;
+	vector<Value> max_values;
+	//! The blocks of the Bloom filter, and the mask to select a block with the lower bits of a hash
+	unsafe_unique_array<atomic<uint64_t>> blocks;
+	idx_t block_mask;
+};
+
+} // namespace duckdb
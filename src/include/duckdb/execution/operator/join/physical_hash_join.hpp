@@ -11,6 +11,7 @@
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/execution/join_hashtable.hpp"
+#include "duckdb/execution/operator/join/join_runtime_filter.hpp"
 #include "duckdb/execution/operator/join/perfect_hash_join_executor.hpp"
 #include "duckdb/execution/operator/join/physical_comparison_join.hpp"
 #include "duckdb/execution/physical_operator.hpp"
@@ -18,6 +19,8 @@
 
 namespace duckdb {
 
+struct DataTableInfo;
+
 //! PhysicalHashJoin represents a hash loop join between two tables
 class PhysicalHashJoin : public PhysicalComparisonJoin {
 public:
@@ -44,11 +47,33 @@ public:
 	vector<LogicalType> delim_types;
 	//! Used in perfect hash join
 	PerfectHashJoinStats perfect_join_statistics;
+	//! Whether the hash table of this join uses linear probing instead of chaining
+	bool linear_probing = false;
+	//! The filter built over the build keys and applied by the table scan on the probe side (if any)
+	shared_ptr<JoinRuntimeFilter> runtime_filter;
+	//! The hash joins above this join whose runtime filters are applied by a table scan on the build side of this
+	//! join. The build side of this join is only scanned once their build sides are complete.
+	vector<const_reference<PhysicalHashJoin>> build_dependencies;
+	//! The fingerprint of the build side, under which its hash table is kept in the JoinHashTableCache (empty if the
+	//! hash table cannot be cached)
+	string cache_key;
+	//! The tables scanned by the build side (if the hash table can be cached)
+	vector<shared_ptr<DataTableInfo>> cache_tables;
+	//! A filter over the output of an inner join (if any). The probe resolves it before it gathers the build columns
+	//! that it does not read, so that these are only gathered for the tuples that pass the filter
+	unique_ptr<Expression> filter;
+	//! Whether the filter reads each of the build columns
+	vector<bool> filter_build_columns;
 
 public:
+	//! Takes over a filter over the output of this join, if the join can resolve it (returns whether it did)
+	bool AddFilter(unique_ptr<Expression> &expr);
+
 	// Operator Interface
 	unique_ptr<OperatorState> GetOperatorState(ExecutionContext &context) const override;
 
+	string ParamsToString() const override;
+
 	bool ParallelOperator() const override {
 		return true;
 	}
@@ -70,6 +70,10 @@ public:
 	bool ParallelSink() const override {
 		return true;
 	}
+
+	bool SinkAcceptsFragments() const override {
+		return true;
+	}
 	bool SinkOrderDependent() const override {
 		return false;
 	}
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "duckdb/execution/operator/join/join_runtime_filter.hpp"
 #include "duckdb/execution/physical_operator.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/planner/table_filter.hpp"
@@ -44,6 +45,8 @@ public:
 	unique_ptr<TableFilterSet> table_filters;
 	//! Currently stores any filters applied to file names (as strings)
 	ExtraOperatorInfo extra_info;
+	//! The runtime filters of the hash joins that probe the output of this scan
+	vector<shared_ptr<JoinRuntimeFilter>> runtime_filters;
 
 public:
 	string GetName() const override;
@@ -71,6 +74,10 @@ public:
 	}
 
 	double GetProgress(ClientContext &context, GlobalSourceState &gstate) const override;
+
+private:
+	//! Removes the tuples that the enabled runtime filters reject from the chunk, and returns how many are left
+	idx_t ApplyRuntimeFilters(DataChunk &chunk, LocalSourceState &lstate) const;
 };
 
 } // namespace duckdb
@@ -14,6 +14,7 @@
 #include "duckdb/common/enums/order_preservation_type.hpp"
 #include "duckdb/common/enums/physical_operator_type.hpp"
 #include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/types/column/column_data_collection.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/execution/execution_context.hpp"
@@ -21,6 +22,7 @@
 #include "duckdb/optimizer/join_order/join_node.hpp"
 
 namespace duckdb {
+class BanditPackage;
 class Event;
 class Executor;
 class PhysicalOperator;
@@ -63,6 +65,10 @@ public:
 	virtual string ParamsToString() const {
 		return "";
 	}
+	//! Describes whether and why the operator compacts its output, shown in EXPLAIN
+	virtual string CompactionToString() const {
+		return "";
+	}
 	virtual string ToString() const;
 	void Print() const;
 	virtual vector<const_reference<PhysicalOperator>> GetChildren() const;
@@ -170,6 +176,12 @@ public:
 		return false;
 	}
 
+	//! Whether the sink consumes sparse chunks (and their selection vectors) as efficiently as full chunks, so the
+	//! operators that feed it do not need to compact their output
+	virtual bool SinkAcceptsFragments() const {
+		return false;
+	}
+
 	//! Whether or not the sink operator depends on the order of the input chunks
 	//! If this is set to true, we cannot do things like caching intermediate vectors
 	virtual bool SinkOrderDependent() const {
@@ -204,8 +216,8 @@ public:
 //! Contains state for the CachingPhysicalOperator
 class CachingOperatorState : public OperatorState {
 public:
-	~CachingOperatorState() override {
-	}
+	CachingOperatorState();
+	~CachingOperatorState() override;
 
 	void Finalize(const PhysicalOperator &op, ExecutionContext &context) override {
 	}
@@ -214,6 +226,44 @@ public:
 	bool initialized = false;
 	//! Whether or not the chunk can be cached
 	bool can_cache_chunk = false;
+	//! Whether chunks emitted for the same input can be compacted by merging their selection vectors
+	bool logical_compaction = false;
+	//! For each column of the cached chunk, whether it is a slice of the current input chunk whose selection vector
+	//! is extended instead of copying rows into it
+	vector<bool> sliced_columns;
+
+	//! The compaction threshold used by this thread
+	idx_t compact_threshold = 0;
+	//! The thread-local bandit that tunes the compaction threshold (if tuning is enabled)
+	unique_ptr<BanditPackage> tuner;
+	//! Measures the time since the current compaction threshold was selected
+	Profiler tuning_timer;
+	//! The number of tuples emitted downstream since the current compaction threshold was selected
+	idx_t emitted_tuples = 0;
+};
+
+//! The compaction stage gathers the small chunks an operator emits into fuller chunks before they are pushed to the
+//! next operator. Compacting operators run it on their own output, and the PipelineExecutor inserts it after other
+//! operators that emit chunks of highly variable size.
+class CompactionStage {
+public:
+	//! The compaction threshold of the stages inserted by the PipelineExecutor
+	static constexpr const idx_t DEFAULT_COMPACT_THRESHOLD = 128;
+
+	//! Initializes the state on the first call and tunes the compaction threshold; called before the operator runs
+	static void Prepare(ExecutionContext &context, const PhysicalOperator &op, idx_t compact_threshold,
+	                    CachingOperatorState &state);
+	//! Compacts the chunk that the operator emitted for the input
+	static void Compact(ExecutionContext &context, const PhysicalOperator &op, DataChunk &input, DataChunk &chunk,
+	                    OperatorResultType result, CachingOperatorState &state);
+	//! Moves the cached rows into the chunk once the operator has processed all input
+	static void Flush(DataChunk &chunk, CachingOperatorState &state);
+	//! Whether the PipelineExecutor inserts a compaction stage after the operator
+	static bool NeedsCompaction(const PhysicalOperator &op);
+
+private:
+	//! Rewards the current compaction threshold with its downstream throughput and selects the next one
+	static void TuneCompactThreshold(CachingOperatorState &state);
 };
 
 //! Base class that caches output from child Operator class. Note that Operators inheriting from this class should also
@@ -224,8 +274,12 @@ public:
 	CompactingPhysicalOperator(PhysicalOperatorType type, vector<LogicalType> types, idx_t estimated_cardinality);
 
 	bool compacting_supported;
+	//! Why the compaction placement enabled or disabled compaction for this operator
+	string compaction_info;
 
 public:
+	string CompactionToString() const override;
+
 	OperatorResultType Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
 	                           GlobalOperatorState &gstate, OperatorState &state) const final;
 	OperatorFinalizeResultType FinalExecute(ExecutionContext &context, DataChunk &chunk, GlobalOperatorState &gstate,
@@ -239,9 +293,6 @@ protected:
 	//! Child classes need to implement the ExecuteInternal method instead of the Execute
 	virtual OperatorResultType ExecuteInternal(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
 	                                           GlobalOperatorState &gstate, OperatorState &state) const = 0;
-
-private:
-	bool CanCacheType(const LogicalType &type);
 };
 
 }  // namespace duckdb
@@ -65,6 +65,38 @@ struct ClientConfig {
 	bool enable_optimizer = true;
 	//! Enable caching operators
 	bool enable_caching_operators = true;
+	//! Tune the compaction threshold of compacting operators at runtime (instead of a fixed threshold)
+	bool enable_compaction_tuning = true;
+	//! Keep the hash tables of hash joins over unchanged base tables across queries
+	bool enable_hash_table_cache = false;
+	//! Buffer the probe side of hash joins that scan a table while the build side runs, and probe from the buffer
+	bool enable_join_early_probe = false;
+	//! Compress the equality keys of hash joins into narrower integers when their statistics bound them
+	bool enable_join_key_compression = false;
+	//! Let hash joins resolve a filter over their output before gathering the build columns the filter does not read
+	bool enable_join_late_materialization = false;
+	//! Prefetch the pointer table entries and tuples of a vector of probe keys before the hash join accesses them
+	bool enable_join_prefetch = false;
+	//! Let hash joins drop the probe tuples that cannot find a match already in the table scan of the probe side
+	bool enable_join_runtime_filter = false;
+	//! Let the runtime filters of hash joins also be applied by the build side scans of the hash joins below them
+	bool enable_join_sideways_filter = false;
+	//! Build the hash tables of hash joins as open-addressing tables with linear probing instead of chaining
+	bool enable_linear_probing_join = false;
+	//! Compact the chunks a compacting operator emits for the same input by merging their selection vectors instead
+	//! of copying their rows. Only operators that emit several chunks per input (HAVE_MORE_OUTPUT), such as joins,
+	//! benefit: filters emit one chunk per input, whose slices are copied before the next input replaces it
+	bool enable_logical_compaction = false;
+	//! Group the rows of pipeline breakers by the hash of the join key of the hash join that probes with them
+	bool enable_breaker_reorder = false;
+	//! Collect per-operator chunk statistics, shown in EXPLAIN ANALYZE and returned by duckdb_chunk_stats()
+	bool enable_chunk_stats = false;
+	//! Disable compaction for the compacting operators for which the estimated cardinalities predict no benefit
+	bool enable_compaction_placement = true;
+	//! Insert compaction stages after projections, unnests and table in-out functions
+	bool enable_compaction_stages = true;
+	//! Probe a perfect hash table for joins on small integer key ranges without duplicates
+	bool enable_perfect_hash_join = false;
 	//! Force parallelism of small tables, used for testing
 	bool verify_parallelism = false;
 	//! Enable the optimizer to consider index joins, which are disabled on default
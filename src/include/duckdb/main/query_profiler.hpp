@@ -10,6 +10,7 @@
 
 #include <stack>
 
+#include "duckdb/common/array.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/deque.hpp"
 #include "duckdb/common/enums/profiler_format.hpp"
@@ -84,6 +85,38 @@ struct ExpressionExecutorInfo {
 	int id;
 };
 
+//! The ChunkStatistics keep track of how full the chunks an operator receives and emits are, and of the work its
+//! compaction buffer does. They are only collected if enable_chunk_stats is set.
+struct ChunkStatistics {
+	//! Chunk sizes are counted per power of two: [1, 2), [2, 4), ..., [2048, ...)
+	static constexpr const idx_t HISTOGRAM_BUCKETS = 12;
+
+	//! The number of input chunks and the number of tuples in them
+	idx_t input_chunks = 0;
+	idx_t input_tuples = 0;
+	//! The number of non-empty output chunks and the number of tuples in them
+	idx_t output_chunks = 0;
+	idx_t output_tuples = 0;
+	array<idx_t, HISTOGRAM_BUCKETS> input_histogram {};
+	array<idx_t, HISTOGRAM_BUCKETS> output_histogram {};
+	//! The number of full compaction buffers emitted
+	idx_t buffer_flushes = 0;
+	//! The number of tuples copied into compaction buffers
+	idx_t tuples_copied = 0;
+
+public:
+	void AddInputChunk(idx_t size);
+	void AddOutputChunk(idx_t size);
+	void Merge(const ChunkStatistics &other);
+	bool IsEmpty() const {
+		return input_chunks == 0 && output_chunks == 0;
+	}
+	//! Renders the statistics for EXPLAIN ANALYZE
+	string ToString() const;
+
+	static idx_t GetBucket(idx_t size);
+};
+
 struct OperatorInformation {
 	explicit OperatorInformation(double time_ = 0, idx_t elements_ = 0) : time(time_), elements(elements_) {
 	}
@@ -91,6 +124,8 @@ struct OperatorInformation {
 	double time = 0;
 	idx_t elements = 0;
 	string name;
+	//! The chunk statistics of the operator
+	ChunkStatistics chunk_stats;
 	//! A vector of Expression Executor Info
 	vector<unique_ptr<ExpressionExecutorInfo>> executors_info;
 };
@@ -100,10 +135,14 @@ class OperatorProfiler {
 	friend class QueryProfiler;
 
 public:
-	DUCKDB_API explicit OperatorProfiler(bool enabled);
+	DUCKDB_API explicit OperatorProfiler(bool enabled, bool chunk_stats_enabled = false);
 
 	DUCKDB_API void StartOperator(optional_ptr<const PhysicalOperator> phys_op);
 	DUCKDB_API void EndOperator(optional_ptr<DataChunk> chunk);
+	//! Records the size of an input chunk that the operator has consumed
+	DUCKDB_API void AddInputChunk(const PhysicalOperator &phys_op, idx_t size);
+	//! Records the tuples the operator copied into its compaction buffer, and whether it emitted a full buffer
+	DUCKDB_API void AddCompaction(const PhysicalOperator &phys_op, idx_t tuples_copied, bool flushed);
 	DUCKDB_API void Flush(const PhysicalOperator &phys_op, ExpressionExecutor &expression_executor, const string &name,
 	                      int id);
 
@@ -120,6 +159,8 @@ private:
 
 	//! Whether or not the profiler is enabled
 	bool enabled;
+	//! Whether or not chunk statistics are collected
+	bool chunk_stats_enabled;
 	//! The timer used to time the execution time of the individual Physical Operators
 	Profiler op;
 	//! The stack of Physical Operators that are currently active
@@ -217,6 +258,9 @@ public:
 	const TreeMap &GetTreeMap() const {
 		return tree_map;
 	}
+	optional_ptr<const TreeNode> GetRoot() const {
+		return root.get();
+	}
 
 private:
 	//! The timer used to time the individual phases of the planning process
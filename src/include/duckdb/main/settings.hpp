@@ -236,6 +236,171 @@ struct EnableHTTPMetadataCacheSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct EnableBreakerReorderSetting {
+	static constexpr const char *Name = "enable_breaker_reorder";
+	static constexpr const char *Description =
+	    "Group the rows of a pipeline breaker by the hash of the join key of the hash join that probes with them";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableCachingOperatorsSetting {
+	static constexpr const char *Name = "enable_caching_operators";
+	static constexpr const char *Description =
+	    "Compact the sparse chunks of filters, joins and projections into a buffer before they are pushed to the next "
+	    "operator";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableChunkStatsSetting {
+	static constexpr const char *Name = "enable_chunk_stats";
+	static constexpr const char *Description =
+	    "Collect the chunk sizes, compaction buffer flushes and copied tuples of every operator, shown in EXPLAIN "
+	    "ANALYZE and returned by duckdb_chunk_stats()";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableCompactionPlacementSetting {
+	static constexpr const char *Name = "enable_compaction_placement";
+	static constexpr const char *Description =
+	    "Decide per compacting operator from the estimated cardinalities whether compacting its output pays off";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableCompactionStagesSetting {
+	static constexpr const char *Name = "enable_compaction_stages";
+	static constexpr const char *Description =
+	    "Compact the output of projections, unnests and table in-out functions before it is pushed to the next operator";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableCompactionTuningSetting {
+	static constexpr const char *Name = "enable_compaction_tuning";
+	static constexpr const char *Description =
+	    "Tune the compaction threshold of every compacting operator at runtime with a multi-armed bandit";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableHashTableCacheSetting {
+	static constexpr const char *Name = "enable_hash_table_cache";
+	static constexpr const char *Description =
+	    "Keep the hash tables of hash joins over unchanged base tables across queries";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinEarlyProbeSetting {
+	static constexpr const char *Name = "enable_join_early_probe";
+	static constexpr const char *Description =
+	    "Buffer the probe side of hash joins that scan a table while the build side runs, and probe from the buffer";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinKeyCompressionSetting {
+	static constexpr const char *Name = "enable_join_key_compression";
+	static constexpr const char *Description =
+	    "Compress the equality keys of hash joins into narrower integers when their statistics bound them";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinLateMaterializationSetting {
+	static constexpr const char *Name = "enable_join_late_materialization";
+	static constexpr const char *Description =
+	    "Let hash joins resolve a filter over their output before gathering the build columns that the filter does not "
+	    "read";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinPrefetchSetting {
+	static constexpr const char *Name = "enable_join_prefetch";
+	static constexpr const char *Description =
+	    "Prefetch the hash table entries and tuples of a vector of probe keys before the hash join accesses them";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinRuntimeFilterSetting {
+	static constexpr const char *Name = "enable_join_runtime_filter";
+	static constexpr const char *Description =
+	    "Drop probe tuples that cannot find a match in the table scan, using the key range and a Bloom filter of the "
+	    "hash join build side";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableJoinSidewaysFilterSetting {
+	static constexpr const char *Name = "enable_join_sideways_filter";
+	static constexpr const char *Description =
+	    "Let the runtime filters of hash joins also be applied by the build side scans of the hash joins below them";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableLinearProbingJoinSetting {
+	static constexpr const char *Name = "enable_linear_probing_join";
+	static constexpr const char *Description =
+	    "Build the hash tables of hash joins as open-addressing tables with linear probing instead of chaining";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnableLogicalCompactionSetting {
+	static constexpr const char *Name = "enable_logical_compaction";
+	static constexpr const char *Description =
+	    "Compact the small chunks a compacting join emits for the same input by merging their selection vectors. The "
+	    "chunks of filters are still copied";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct EnablePerfectHashJoinSetting {
+	static constexpr const char *Name = "enable_perfect_hash_join";
+	static constexpr const char *Description =
+	    "Probe a perfect hash table for inner joins on a small integer key range without duplicate keys";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static void ResetLocal(ClientContext &context);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct EnableProfilingSetting {
 	static constexpr const char *Name = "enable_profiling";
 	static constexpr const char *Description =
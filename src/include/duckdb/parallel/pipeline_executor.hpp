@@ -75,6 +75,8 @@ private:
 	vector<unique_ptr<DataChunk>> intermediate_chunks;
 	//! Intermediate states for the operators
 	vector<unique_ptr<OperatorState>> intermediate_states;
+	//! States of the compaction stages inserted after the operators (nullptr if the operator has no stage)
+	vector<unique_ptr<CachingOperatorState>> compaction_states;
 
 	//! The local source state
 	unique_ptr<LocalSourceState> local_source_state;
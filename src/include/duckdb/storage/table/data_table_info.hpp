@@ -26,6 +26,9 @@ struct DataTableInfo {
 	//! The amount of elements in the table. Note that this number signifies the amount of COMMITTED entries in the
 	//! table. It can be inaccurate inside of transactions. More work is needed to properly support that.
 	atomic<idx_t> cardinality;
+	//! The commit id of the latest committed change to the data or the definition of the table (0 if the table has not
+	//! been changed since it was loaded)
+	atomic<transaction_t> last_commit_id;
 	// schema of the table
 	string schema;
 	// name of the table
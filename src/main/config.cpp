@@ -75,6 +75,22 @@ static ConfigurationOption internal_options[] = {DUCKDB_GLOBAL(AccessModeSetting
                                                  DUCKDB_GLOBAL(AutoloadKnownExtensions),
                                                  DUCKDB_GLOBAL(EnableObjectCacheSetting),
                                                  DUCKDB_GLOBAL(EnableHTTPMetadataCacheSetting),
+                                                 DUCKDB_LOCAL(EnableBreakerReorderSetting),
+                                                 DUCKDB_LOCAL(EnableCachingOperatorsSetting),
+                                                 DUCKDB_LOCAL(EnableChunkStatsSetting),
+                                                 DUCKDB_LOCAL(EnableCompactionPlacementSetting),
+                                                 DUCKDB_LOCAL(EnableCompactionStagesSetting),
+                                                 DUCKDB_LOCAL(EnableCompactionTuningSetting),
+                                                 DUCKDB_LOCAL(EnableHashTableCacheSetting),
+                                                 DUCKDB_LOCAL(EnableJoinEarlyProbeSetting),
+                                                 DUCKDB_LOCAL(EnableJoinKeyCompressionSetting),
+                                                 DUCKDB_LOCAL(EnableJoinLateMaterializationSetting),
+                                                 DUCKDB_LOCAL(EnableJoinPrefetchSetting),
+                                                 DUCKDB_LOCAL(EnableJoinRuntimeFilterSetting),
+                                                 DUCKDB_LOCAL(EnableJoinSidewaysFilterSetting),
+                                                 DUCKDB_LOCAL(EnableLinearProbingJoinSetting),
+                                                 DUCKDB_LOCAL(EnableLogicalCompactionSetting),
+                                                 DUCKDB_LOCAL(EnablePerfectHashJoinSetting),
                                                  DUCKDB_LOCAL(EnableProfilingSetting),
                                                  DUCKDB_LOCAL(EnableProgressBarSetting),
                                                  DUCKDB_LOCAL(EnableProgressBarPrintSetting),
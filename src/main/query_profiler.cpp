@@ -26,7 +26,11 @@ QueryProfiler::QueryProfiler(ClientContext &context_p)
 }
 
 bool QueryProfiler::IsEnabled() const {
-	return is_explain_analyze ? true : ClientConfig::GetConfig(context).enable_profiler;
+	if (is_explain_analyze) {
+		return true;
+	}
+	auto &config = ClientConfig::GetConfig(context);
+	return config.enable_profiler || config.enable_chunk_stats;
 }
 
 bool QueryProfiler::IsDetailedEnabled() const {
@@ -136,8 +140,8 @@ void QueryProfiler::EndQuery() {
 	}
 	this->running = false;
 	// print or output the query profiling after termination
-	// EXPLAIN ANALYSE should not be outputted by the profiler
-	if (IsEnabled() && !is_explain_analyze) {
+	// EXPLAIN ANALYSE should not be outputted by the profiler, nor should queries that only collect chunk statistics
+	if (ClientConfig::GetConfig(context).enable_profiler && !is_explain_analyze) {
 		string query_info = ToString();
 		auto save_location = GetSaveLocation();
 		if (!ClientConfig::GetConfig(context).emit_profiler_output) {
@@ -224,7 +228,66 @@ void QueryProfiler::Initialize(const PhysicalOperator &root_op) {
 	}
 }
 
-OperatorProfiler::OperatorProfiler(bool enabled_p) : enabled(enabled_p), active_operator(nullptr) {
+idx_t ChunkStatistics::GetBucket(idx_t size) {
+	D_ASSERT(size > 0);
+	idx_t bucket = 0;
+	while (size > 1 && bucket + 1 < HISTOGRAM_BUCKETS) {
+		size >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+void ChunkStatistics::AddInputChunk(idx_t size) {
+	if (size == 0) {
+		return;
+	}
+	input_chunks++;
+	input_tuples += size;
+	input_histogram[GetBucket(size)]++;
+}
+
+void ChunkStatistics::AddOutputChunk(idx_t size) {
+	if (size == 0) {
+		return;
+	}
+	output_chunks++;
+	output_tuples += size;
+	output_histogram[GetBucket(size)]++;
+}
+
+void ChunkStatistics::Merge(const ChunkStatistics &other) {
+	input_chunks += other.input_chunks;
+	input_tuples += other.input_tuples;
+	output_chunks += other.output_chunks;
+	output_tuples += other.output_tuples;
+	for (idx_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		input_histogram[i] += other.input_histogram[i];
+		output_histogram[i] += other.output_histogram[i];
+	}
+	buffer_flushes += other.buffer_flushes;
+	tuples_copied += other.tuples_copied;
+}
+
+string ChunkStatistics::ToString() const {
+	string result;
+	if (input_chunks > 0) {
+		result += StringUtil::Format("in: %llu chunks (avg %llu)\n", input_chunks, input_tuples / input_chunks);
+	}
+	if (output_chunks > 0) {
+		result += StringUtil::Format("out: %llu chunks (avg %llu)\n", output_chunks, output_tuples / output_chunks);
+	}
+	if (buffer_flushes > 0 || tuples_copied > 0) {
+		result += StringUtil::Format("flushes: %llu\ncopied: %llu\n", buffer_flushes, tuples_copied);
+	}
+	if (!result.empty()) {
+		result.pop_back();
+	}
+	return result;
+}
+
+OperatorProfiler::OperatorProfiler(bool enabled_p, bool chunk_stats_enabled_p)
+    : enabled(enabled_p), chunk_stats_enabled(enabled_p && chunk_stats_enabled_p), active_operator(nullptr) {
 }
 
 void OperatorProfiler::StartOperator(optional_ptr<const PhysicalOperator> phys_op) {
@@ -255,9 +318,28 @@ void OperatorProfiler::EndOperator(optional_ptr<DataChunk> chunk) {
 	op.End();
 
 	AddTiming(*active_operator, op.Elapsed(), chunk ? chunk->size() : 0);
+	if (chunk_stats_enabled && chunk) {
+		timings[*active_operator].chunk_stats.AddOutputChunk(chunk->size());
+	}
 	active_operator = nullptr;
 }
 
+void OperatorProfiler::AddInputChunk(const PhysicalOperator &phys_op, idx_t size) {
+	if (!chunk_stats_enabled) {
+		return;
+	}
+	timings[phys_op].chunk_stats.AddInputChunk(size);
+}
+
+void OperatorProfiler::AddCompaction(const PhysicalOperator &phys_op, idx_t tuples_copied, bool flushed) {
+	if (!chunk_stats_enabled) {
+		return;
+	}
+	auto &chunk_stats = timings[phys_op].chunk_stats;
+	chunk_stats.tuples_copied += tuples_copied;
+	chunk_stats.buffer_flushes += flushed;
+}
+
 void OperatorProfiler::AddTiming(const PhysicalOperator &op, double time, idx_t elements) {
 	if (!enabled) {
 		return;
@@ -302,6 +384,7 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 
 		tree_node.info.time += node.second.time;
 		tree_node.info.elements += node.second.elements;
+		tree_node.info.chunk_stats.Merge(node.second.chunk_stats);
 		if (!IsDetailedEnabled()) {
 			continue;
 		}
@@ -470,6 +470,247 @@ Value EnableHTTPMetadataCacheSetting::GetSetting(ClientContext &context) {
 	return Value::BOOLEAN(config.options.http_metadata_cache_enable);
 }
 
+//===--------------------------------------------------------------------===//
+// Enable Breaker Reorder
+//===--------------------------------------------------------------------===//
+void EnableBreakerReorderSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_breaker_reorder = ClientConfig().enable_breaker_reorder;
+}
+
+void EnableBreakerReorderSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_breaker_reorder = input.GetValue<bool>();
+}
+
+Value EnableBreakerReorderSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_breaker_reorder);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Caching Operators
+//===--------------------------------------------------------------------===//
+void EnableCachingOperatorsSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_caching_operators = ClientConfig().enable_caching_operators;
+}
+
+void EnableCachingOperatorsSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_caching_operators = input.GetValue<bool>();
+}
+
+Value EnableCachingOperatorsSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_caching_operators);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Chunk Stats
+//===--------------------------------------------------------------------===//
+void EnableChunkStatsSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_chunk_stats = ClientConfig().enable_chunk_stats;
+}
+
+void EnableChunkStatsSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_chunk_stats = input.GetValue<bool>();
+}
+
+Value EnableChunkStatsSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_chunk_stats);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Compaction Placement
+//===--------------------------------------------------------------------===//
+void EnableCompactionPlacementSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_compaction_placement = ClientConfig().enable_compaction_placement;
+}
+
+void EnableCompactionPlacementSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_compaction_placement = input.GetValue<bool>();
+}
+
+Value EnableCompactionPlacementSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_compaction_placement);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Compaction Stages
+//===--------------------------------------------------------------------===//
+void EnableCompactionStagesSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_compaction_stages = ClientConfig().enable_compaction_stages;
+}
+
+void EnableCompactionStagesSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_compaction_stages = input.GetValue<bool>();
+}
+
+Value EnableCompactionStagesSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_compaction_stages);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Compaction Tuning
+//===--------------------------------------------------------------------===//
+void EnableCompactionTuningSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_compaction_tuning = ClientConfig().enable_compaction_tuning;
+}
+
+void EnableCompactionTuningSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_compaction_tuning = input.GetValue<bool>();
+}
+
+Value EnableCompactionTuningSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_compaction_tuning);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Hash Table Cache
+//===--------------------------------------------------------------------===//
+void EnableHashTableCacheSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_hash_table_cache = ClientConfig().enable_hash_table_cache;
+}
+
+void EnableHashTableCacheSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_hash_table_cache = input.GetValue<bool>();
+}
+
+Value EnableHashTableCacheSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_hash_table_cache);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Early Probe
+//===--------------------------------------------------------------------===//
+void EnableJoinEarlyProbeSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_early_probe = ClientConfig().enable_join_early_probe;
+}
+
+void EnableJoinEarlyProbeSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_early_probe = input.GetValue<bool>();
+}
+
+Value EnableJoinEarlyProbeSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_early_probe);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Key Compression
+//===--------------------------------------------------------------------===//
+void EnableJoinKeyCompressionSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_key_compression = ClientConfig().enable_join_key_compression;
+}
+
+void EnableJoinKeyCompressionSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_key_compression = input.GetValue<bool>();
+}
+
+Value EnableJoinKeyCompressionSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_key_compression);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Late Materialization
+//===--------------------------------------------------------------------===//
+void EnableJoinLateMaterializationSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_late_materialization =
+	    ClientConfig().enable_join_late_materialization;
+}
+
+void EnableJoinLateMaterializationSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_late_materialization = input.GetValue<bool>();
+}
+
+Value EnableJoinLateMaterializationSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_late_materialization);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Prefetch
+//===--------------------------------------------------------------------===//
+void EnableJoinPrefetchSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_prefetch = ClientConfig().enable_join_prefetch;
+}
+
+void EnableJoinPrefetchSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_prefetch = input.GetValue<bool>();
+}
+
+Value EnableJoinPrefetchSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_prefetch);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Runtime Filter
+//===--------------------------------------------------------------------===//
+void EnableJoinRuntimeFilterSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_runtime_filter = ClientConfig().enable_join_runtime_filter;
+}
+
+void EnableJoinRuntimeFilterSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_runtime_filter = input.GetValue<bool>();
+}
+
+Value EnableJoinRuntimeFilterSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_runtime_filter);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Join Sideways Filter
+//===--------------------------------------------------------------------===//
+void EnableJoinSidewaysFilterSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_join_sideways_filter = ClientConfig().enable_join_sideways_filter;
+}
+
+void EnableJoinSidewaysFilterSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_join_sideways_filter = input.GetValue<bool>();
+}
+
+Value EnableJoinSidewaysFilterSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_join_sideways_filter);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Linear Probing Join
+//===--------------------------------------------------------------------===//
+void EnableLinearProbingJoinSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_linear_probing_join = ClientConfig().enable_linear_probing_join;
+}
+
+void EnableLinearProbingJoinSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_linear_probing_join = input.GetValue<bool>();
+}
+
+Value EnableLinearProbingJoinSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_linear_probing_join);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Logical Compaction
+//===--------------------------------------------------------------------===//
+void EnableLogicalCompactionSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_logical_compaction = ClientConfig().enable_logical_compaction;
+}
+
+void EnableLogicalCompactionSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_logical_compaction = input.GetValue<bool>();
+}
+
+Value EnableLogicalCompactionSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_logical_compaction);
+}
+
+//===--------------------------------------------------------------------===//
+// Enable Perfect Hash Join
+//===--------------------------------------------------------------------===//
+void EnablePerfectHashJoinSetting::ResetLocal(ClientContext &context) {
+	ClientConfig::GetConfig(context).enable_perfect_hash_join = ClientConfig().enable_perfect_hash_join;
+}
+
+void EnablePerfectHashJoinSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_perfect_hash_join = input.GetValue<bool>();
+}
+
+Value EnablePerfectHashJoinSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_perfect_hash_join);
+}
+
 //===--------------------------------------------------------------------===//
 // Enable Profiling
 //===--------------------------------------------------------------------===//
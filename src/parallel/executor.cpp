@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "duckdb/common/negative_feedback.hpp"
 #include "duckdb/execution/execution_context.hpp"
 #include "duckdb/execution/operator/helper/physical_result_collector.hpp"
 #include "duckdb/execution/operator/set/physical_cte.hpp"
@@ -20,7 +21,7 @@
 
 namespace duckdb {
 
-Executor::Executor(ClientContext &context) : context(context) {
+Executor::Executor(ClientContext &context) : context(context), compact_tuner(make_uniq<CompactTuner>()) {
 }
 
 Executor::~Executor() {
@@ -542,6 +543,7 @@ void Executor::Reset() {
 	pipelines.clear();
 	events.clear();
 	to_be_rescheduled_tasks.clear();
+	compact_tuner->Reset();
 	execution_result = PendingExecutionResult::RESULT_NOT_READY;
 }
 
@@ -30,6 +30,8 @@ PipelineExecutor::PipelineExecutor(ClientContext &context_p, Pipeline &pipeline_
 
 	intermediate_chunks.reserve(pipeline.operators.size());
 	intermediate_states.reserve(pipeline.operators.size());
+	compaction_states.reserve(pipeline.operators.size());
+	auto compaction_stages = ClientConfig::GetConfig(context.client).enable_compaction_stages;
 	for (idx_t i = 0; i < pipeline.operators.size(); i++) {
 		auto &prev_operator = i == 0 ? *pipeline.source : pipeline.operators[i - 1].get();
 		auto &current_operator = pipeline.operators[i].get();
@@ -41,6 +43,12 @@ PipelineExecutor::PipelineExecutor(ClientContext &context_p, Pipeline &pipeline_
 		auto op_state = current_operator.GetOperatorState(context);
 		intermediate_states.push_back(std::move(op_state));
 
+		if (compaction_stages && CompactionStage::NeedsCompaction(current_operator)) {
+			compaction_states.push_back(make_uniq<CachingOperatorState>());
+		} else {
+			compaction_states.push_back(nullptr);
+		}
+
 		if (current_operator.IsSink() && current_operator.sink_state->state == SinkFinalizeType::NO_OUTPUT_POSSIBLE) {
 			// one of the operators has already figured out no output is possible
 			// we can skip executing the pipeline
@@ -58,9 +66,15 @@ bool PipelineExecutor::TryFlushCachingOperators() {
 		flushing_idx = IsFinished() ? idx_t(finished_processing_idx) : 0;
 	}
 
-	// Go over each operator and keep flushing them using `FinalExecute` until empty
+	// Go over each operator and keep flushing them using `FinalExecute` (or their compaction stage) until empty
 	while (flushing_idx < pipeline.operators.size()) {
-		if (!pipeline.operators[flushing_idx].get().RequiresFinalExecute()) {
+		if (IsFinished() && flushing_idx < idx_t(finished_processing_idx)) {
+			// an operator after the flushed one (or the sink) has finished: only the operators after it are flushed
+			flushing_idx = idx_t(finished_processing_idx);
+			should_flush_current_idx = true;
+			continue;
+		}
+		if (!pipeline.operators[flushing_idx].get().RequiresFinalExecute() && !compaction_states[flushing_idx]) {
 			flushing_idx++;
 			continue;
 		}
@@ -83,8 +97,13 @@ bool PipelineExecutor::TryFlushCachingOperators() {
 		if (in_process_operators.empty()) {
 			curr_chunk.Reset();
 			StartOperator(current_operator);
-			finalize_result = current_operator.FinalExecute(context, curr_chunk, *current_operator.op_state,
-			                                                *intermediate_states[flushing_idx]);
+			if (compaction_states[flushing_idx]) {
+				CompactionStage::Flush(curr_chunk, *compaction_states[flushing_idx]);
+				finalize_result = OperatorFinalizeResultType::FINISHED;
+			} else {
+				finalize_result = current_operator.FinalExecute(context, curr_chunk, *current_operator.op_state,
+				                                                *intermediate_states[flushing_idx]);
+			}
 			EndOperator(current_operator, &curr_chunk);
 		} else {
 			// Reset flag and reflush the last chunk we were flushing.
@@ -102,8 +121,6 @@ bool PipelineExecutor::TryFlushCachingOperators() {
 		if (push_result == OperatorResultType::BLOCKED) {
 			remaining_sink_chunk = true;
 			return false;
-		} else if (push_result == OperatorResultType::FINISHED) {
-			break;
 		}
 	}
 	return true;
@@ -183,8 +200,8 @@ PipelineExecuteResult PipelineExecutor::Execute(idx_t max_chunks) {
 			// the result for the pipeline
 			D_ASSERT(source_chunk.size() > 0);
 			result = ExecutePushInternal(source_chunk);
-		} else if (exhausted_source && !next_batch_blocked && !done_flushing) {
-			// The source was exhausted, try flushing all operators
+		} else if ((exhausted_source || IsFinished()) && !next_batch_blocked && !done_flushing) {
+			// The source was exhausted or an operator finished, try flushing all operators
 			auto flush_completed = TryFlushCachingOperators();
 			if (flush_completed) {
 				done_flushing = true;
@@ -229,13 +246,9 @@ PipelineExecuteResult PipelineExecutor::Execute(idx_t max_chunks) {
 			remaining_sink_chunk = true;
 			return PipelineExecuteResult::INTERRUPTED;
 		}
-
-		if (result == OperatorResultType::FINISHED) {
-			break;
-		}
 	}
 
-	if ((!exhausted_source || !done_flushing) && !IsFinished()) {
+	if (!done_flushing || (!exhausted_source && !IsFinished())) {
 		return PipelineExecuteResult::NOT_FINISHED;
 	}
 
@@ -290,6 +303,7 @@ OperatorResultType PipelineExecutor::ExecutePushInternal(DataChunk &input, idx_t
 			auto sink_result = Sink(sink_chunk, sink_input);
 
 			EndOperator(*pipeline.sink, nullptr);
+			context.thread.profiler.AddInputChunk(*pipeline.sink, sink_chunk.size());
 
 			if (sink_result == SinkResultType::BLOCKED) {
 				return OperatorResultType::BLOCKED;
@@ -468,17 +482,33 @@ OperatorResultType PipelineExecutor::Execute(DataChunk &input, DataChunk &result
 			// if current_idx > source_idx, we pass the previous operators' output through the Execute of the current
 			// operator
 			StartOperator(current_operator);
+			auto &compaction_state = compaction_states[operator_idx];
+			if (compaction_state) {
+				CompactionStage::Prepare(context, current_operator, CompactionStage::DEFAULT_COMPACT_THRESHOLD,
+				                         *compaction_state);
+			}
 			auto result = current_operator.Execute(context, prev_chunk, current_chunk, *current_operator.op_state,
 			                                       *intermediate_states[current_intermediate - 1]);
+			if (compaction_state) {
+				CompactionStage::Compact(context, current_operator, prev_chunk, current_chunk, result,
+				                         *compaction_state);
+			}
 			EndOperator(current_operator, &current_chunk);
+			if (result != OperatorResultType::HAVE_MORE_OUTPUT) {
+				// the operator has consumed its input
+				context.thread.profiler.AddInputChunk(current_operator, prev_chunk.size());
+			}
 			if (result == OperatorResultType::HAVE_MORE_OUTPUT) {
 				// more data remains in this operator
 				// push in-process marker
 				in_process_operators.push(current_idx);
 			} else if (result == OperatorResultType::FINISHED) {
-				D_ASSERT(current_chunk.size() == 0);
 				FinishProcessing(current_idx);
-				return OperatorResultType::FINISHED;
+				if (current_chunk.size() == 0) {
+					return OperatorResultType::FINISHED;
+				}
+				// the compaction of the operator emitted the rows it still held: push them through the rest of the
+				// pipeline, the operators after it are flushed afterwards
 			}
 			current_chunk.Verify();
 		}
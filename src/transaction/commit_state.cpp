@@ -259,6 +259,11 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 		if (catalog_entry->name != catalog_entry->parent->name) {
 			catalog_entry->set->UpdateTimestamp(*catalog_entry, commit_id);
 		}
+		if (catalog_entry->parent->type == CatalogType::TABLE_ENTRY) {
+			// altering a table can change its data without appends, deletes or updates
+			auto &table = catalog_entry->parent->Cast<DuckTableEntry>();
+			table.GetStorage().info->last_commit_id = commit_id;
+		}
 		if (HAS_LOG) {
 			// push the catalog update to the WAL
 			WriteCatalogEntry(*catalog_entry, data + sizeof(CatalogEntry *));
@@ -273,6 +278,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 		}
 		// mark the tuples as committed
 		info->table->CommitAppend(commit_id, info->start_row, info->count);
+		info->table->info->last_commit_id = commit_id;
 		break;
 	}
 	case UndoFlags::DELETE_TUPLE: {
@@ -283,6 +289,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 		}
 		// mark the tuples as committed
 		info->version_info->CommitDelete(info->vector_idx, commit_id, info->rows, info->count);
+		info->table->info->last_commit_id = commit_id;
 		break;
 	}
 	case UndoFlags::UPDATE_TUPLE: {
@@ -292,6 +299,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 			WriteUpdate(*info);
 		}
 		info->version_number = commit_id;
+		info->segment->column_data.GetTableInfo().last_commit_id = commit_id;
 		break;
 	}
 	default:
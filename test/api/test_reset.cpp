@@ -69,8 +69,24 @@ OptionValueSet &GetValueForOption(const string &name) {
 #else
 	    {"autoinstall_known_extensions", {true}},
 #endif
+	    {"enable_breaker_reorder", {true}},
+	    {"enable_caching_operators", {false}},
+	    {"enable_chunk_stats", {true}},
+	    {"enable_compaction_placement", {false}},
+	    {"enable_compaction_stages", {false}},
+	    {"enable_compaction_tuning", {false}},
 	    {"enable_fsst_vectors", {true}},
+	    {"enable_hash_table_cache", {true}},
+	    {"enable_join_early_probe", {true}},
+	    {"enable_join_key_compression", {true}},
+	    {"enable_join_late_materialization", {true}},
+	    {"enable_join_prefetch", {true}},
+	    {"enable_join_runtime_filter", {true}},
+	    {"enable_join_sideways_filter", {true}},
+	    {"enable_linear_probing_join", {true}},
+	    {"enable_logical_compaction", {true}},
 	    {"enable_object_cache", {true}},
+	    {"enable_perfect_hash_join", {true}},
 	    {"enable_profiling", {"json"}},
 	    {"enable_progress_bar", {true}},
 	    {"explain_output", {{"all", "optimized_only", "physical_only"}}},
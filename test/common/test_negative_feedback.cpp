@@ -0,0 +1,37 @@
+#include "catch.hpp"
+#include "duckdb/common/negative_feedback.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+//! Runs the bandits of two threads that share their estimates, and returns how often each arm was selected
+static unordered_map<size_t, idx_t> RunBandits(BanditPackage &first, BanditPackage &second, size_t best_arm,
+                                               double best_reward, idx_t iterations) {
+	unordered_map<size_t, idx_t> selections;
+	for (idx_t i = 0; i < iterations; i++) {
+		for (auto package : {&first, &second}) {
+			auto arm = package->SelectArm();
+			package->UpdateArm(arm, arm == best_arm ? best_reward : 0.1);
+			selections[arm]++;
+		}
+	}
+	return selections;
+}
+
+TEST_CASE("Test that shared bandit estimates re-converge after the rewards shift", "[negative_feedback]") {
+	std::vector<size_t> arms {32, 64, 128, 256};
+	CompactTuner tuner;
+	auto first = tuner.CreateBandit(0, arms);
+	auto second = tuner.CreateBandit(0, arms);
+	REQUIRE(tuner.GetBanditSize() == 1);
+
+	auto selections = RunBandits(*first, *second, 32, 1.0, 5000);
+	REQUIRE(selections[32] > 9000);
+
+	// the best arm changes, and its reward is lower than the old best reward: the rewards from before the shift must
+	// not be merged back into the restarted bandits, or they keep selecting the old arm
+	RunBandits(*first, *second, 256, 0.4, 5000);
+	selections = RunBandits(*first, *second, 256, 0.4, 1000);
+	REQUIRE(selections[256] > 1900);
+	REQUIRE(selections[32] < 100);
+}
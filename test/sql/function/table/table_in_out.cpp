@@ -135,3 +135,86 @@ TEST_CASE("Parallel execution with caching table in out functions", "[filter][.]
 	REQUIRE(result2->RowCount() == 200000);
 	REQUIRE(CHECK_COLUMN(result2, 0, {0, 1, 2, 3, 4, 5}));
 }
+
+// Dummy TableInOutFunction that:
+// - echoes its INTEGER input, emitting at most 100 rows per call
+// - returns FINISHED once it has emitted 1000 rows, like a limit would
+struct LimitedEcho {
+	static constexpr const idx_t ROWS_PER_CALL = 100;
+	static constexpr const idx_t LIMIT = 1000;
+
+	struct LimitedEchoLocalData : public LocalTableFunctionState {
+		LimitedEchoLocalData() {
+		}
+		idx_t input_offset = 0;
+		idx_t emitted = 0;
+	};
+
+	static duckdb::unique_ptr<LocalTableFunctionState> LimitedEchoLocalInit(ExecutionContext &context,
+	                                                                        TableFunctionInitInput &input,
+	                                                                        GlobalTableFunctionState *global_state) {
+		return make_uniq<LimitedEchoLocalData>();
+	}
+
+	static duckdb::unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                             duckdb::vector<LogicalType> &return_types,
+	                                             duckdb::vector<string> &names) {
+		return_types.emplace_back(LogicalType::INTEGER);
+		names.emplace_back("x");
+		return make_uniq<TableFunctionData>();
+	}
+
+	static OperatorResultType Function(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+	                                   DataChunk &output) {
+		auto &local_state = data_p.local_state->Cast<LimitedEcho::LimitedEchoLocalData>();
+		if (local_state.emitted >= LIMIT) {
+			return OperatorResultType::FINISHED;
+		}
+		auto to_emit = MinValue<idx_t>(ROWS_PER_CALL, input.size() - local_state.input_offset);
+		to_emit = MinValue<idx_t>(to_emit, LIMIT - local_state.emitted);
+		for (idx_t i = 0; i < to_emit; i++) {
+			output.SetValue(0, i, input.GetValue(0, local_state.input_offset + i));
+		}
+		output.SetCardinality(to_emit);
+		local_state.input_offset += to_emit;
+		local_state.emitted += to_emit;
+		if (local_state.input_offset < input.size()) {
+			return OperatorResultType::HAVE_MORE_OUTPUT;
+		}
+		local_state.input_offset = 0;
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+
+	static void Register(Connection &con) {
+		con.BeginTransaction();
+		auto &client_context = *con.context;
+		auto &catalog = Catalog::GetSystemCatalog(client_context);
+		TableFunction limited_echo("limited_echo", {LogicalType::TABLE}, nullptr, LimitedEcho::Bind, nullptr,
+		                           LimitedEcho::LimitedEchoLocalInit);
+		limited_echo.in_out_function = LimitedEcho::Function;
+		CreateTableFunctionInfo limited_echo_info(limited_echo);
+		catalog.CreateTableFunction(*con.context, limited_echo_info);
+		con.Commit();
+	}
+};
+
+TEST_CASE("Table in-out function that finishes while its compaction stage holds rows", "[filter]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	LimitedEcho::Register(con);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+	REQUIRE_NO_FAIL(con.Query("SET enable_compaction_tuning=false"));
+
+	// the chunks of 100 rows are held by the compaction stage after the function until it finishes
+	auto result = con.Query("SELECT COUNT(*), SUM(x) FROM limited_echo((SELECT i::INTEGER FROM range(0, 100000) "
+	                        "tbl(i))) JOIN (SELECT i::INTEGER AS y FROM range(0, 5000) tbl(i)) ON x = y");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {499500}));
+
+	REQUIRE_NO_FAIL(con.Query("SET enable_compaction_stages=false"));
+	result = con.Query("SELECT COUNT(*), SUM(x) FROM limited_echo((SELECT i::INTEGER FROM range(0, 100000) "
+	                   "tbl(i))) JOIN (SELECT i::INTEGER AS y FROM range(0, 5000) tbl(i)) ON x = y");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {499500}));
+}
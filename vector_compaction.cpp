@@ -21,8 +21,6 @@ void ExecuteQuery(duckdb::Connection &con, std::string query, size_t running_tim
 		duckdb::ZebraProfiler::Get().ToCSV();
 		duckdb::ZebraProfiler::Get().Clear();
 
-		duckdb::CompactTuner::Get().Reset();
-
 		if (i >= running_times - showing_times) {
 			std::cerr
 			    << "-------------------------------------------------------------------------------------------------"